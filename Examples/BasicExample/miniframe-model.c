@@ -84,6 +84,22 @@ bool MFModelStatusIsSame(const MFModelStatus* const that,
     return false;
 }
 
+// Return the hash of the MFModelStatus 'that', used by MiniFrame to 
+// index the computed worlds
+// Two MFModelStatus considered as the same by MFModelStatusIsSame must 
+// have the same hash
+unsigned long MFModelStatusHash(const MFModelStatus* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return ((unsigned long)(that->_pos + 5) << 4) ^ 
+    (unsigned long)(that->_tgt + 5);
+}
+
 // Return the index of the actor who has preemption in the MFModelStatus
 // 'that'
 // If no actor has preemption (all the actor act simultaneously)
@@ -73,6 +73,12 @@ void MFModelTransitionFreeStatic(MFModelTransition* that);
 bool MFModelStatusIsSame(const MFModelStatus* const that,
   const MFModelStatus* const tho);
 
+// Return the hash of the MFModelStatus 'that', used by MiniFrame to 
+// index the computed worlds
+// Two MFModelStatus considered as the same by MFModelStatusIsSame must 
+// have the same hash
+unsigned long MFModelStatusHash(const MFModelStatus* const that);
+
 // Return the index of the actor who has preemption in the MFModelStatus
 // 'that'
 // If no actor has preemption (all the actor act simultaneously)
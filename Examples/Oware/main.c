@@ -47,10 +47,11 @@ void RunDemo(float expansionTime, bool useNN) {
   // Loop until end of game
   while (!MFModelStatusIsEnd(&curWorld) && !flagEnd) {
     printf("-----------\n");
+    // Correct the current world in the MiniFrame, which stops the 
+    // pondering
+    MFSetCurWorld(mf, &curWorld);
     // Set the start clock
     MFSetStartExpandClock(mf, clock());
-    // Correct the current world in the MiniFrame
-    MFSetCurWorld(mf, &curWorld);
     // Display info
     printf("computed: %d, ", MFGetNbComputedWorlds(mf));
     printf("to expand: %d, ", MFGetNbWorldsToExpand(mf));
@@ -81,6 +82,8 @@ void RunDemo(float expansionTime, bool useNN) {
         printf("\n");
         // Step with best transition
         curWorld = MFModelStatusStep(&curWorld, bestTrans);
+        // Expand in background while the opponent thinks
+        MFStartPondering(mf);
       } else {
         flagEnd = true;
       }
@@ -92,7 +95,9 @@ void RunDemo(float expansionTime, bool useNN) {
     printf("\n");
     fflush(stdout);
   }
-  // Free memory
+  // Free memory, the pondering uses the NeuraNet so it must be stopped
+  // first
+  MFStopPondering(mf);
   for (int iPlayer = NBPLAYER; iPlayer--;) {
     if (curWorld._nn[iPlayer] != NULL)
       NeuraNetFree(curWorld._nn + iPlayer);
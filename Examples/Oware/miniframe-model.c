@@ -86,6 +86,29 @@ bool MFModelStatusIsSame(const MFModelStatus* const that,
   return ret;
 }
 
+// Return the hash of the MFModelStatus 'that', used by MiniFrame to 
+// index the computed worlds
+// Two MFModelStatus considered as the same by MFModelStatusIsSame must 
+// have the same hash
+unsigned long MFModelStatusHash(const MFModelStatus* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // FNV-1a on the properties compared in MFModelStatusIsSame
+  unsigned long hash = 2166136261UL;
+  hash = (hash ^ (unsigned long)that->_curPlayer) * 16777619UL;
+  hash = (hash ^ (unsigned long)that->_end) * 16777619UL;
+  for (int iPlayer = NBPLAYER; iPlayer--;)
+    hash = (hash ^ (unsigned long)that->_score[iPlayer]) * 16777619UL;
+  for (int iHole = NBHOLE; iHole--;)
+    hash = (hash ^ (unsigned long)that->_nbStone[iHole]) * 16777619UL;
+  return hash;
+}
+
 // Return the index of the actor who has preemption in the MFModelStatus
 // 'that'
 // If no actor has preemption (all the actor act simultaneously)
@@ -11,11 +11,25 @@
 
 #define RANDOMSEED 0
 
+// Internal functions of miniframe.c checked on handmade graphs of 
+// worlds
+void MFWorldSetTransitionToWorld(
+  MFWorld* const that, const int iTrans, MFWorld* const toWorld);
+void MFUpdateForecastValues(MiniFrame* const that, 
+  const MFWorld* const world);
+void MFMarkWorldDirty(MiniFrame* const that, MFWorld* const world);
+MFWorld* MFSearchWorld(const MiniFrame* const that, 
+  const MFModelStatus* const status, const MFWorld* const excluded);
+void MFUpdateDirtyForecastValues(MiniFrame* const that);
+
 void UnitTestMFTransitionCreateFree() {
   MFWorld world;
   MFModelTransition trans = {._move = 1};
   MFTransition act = MFTransitionCreateStatic(&world, &trans);
-  if (act._fromWorld != &world ||
+  if (
+#if MF_COMPACTTRANSITION == false
+    act._fromWorld != &world ||
+#endif
     act._toWorld != NULL ||
     memcmp(&(act._transition), &(trans), 
       sizeof(MFModelTransition)) != 0) {
@@ -37,29 +51,41 @@ void UnitTestMFTransitionCreateFree() {
 void UnitTestMFTransitionIsExpandable() {
   MFModelStatus status = {._step = 0, ._pos = 0, ._tgt = 1};
   MFWorld* world = MFWorldCreate(&status);
+#if MF_COMPACTTRANSITION
+  // Compact transitions get their world from their position in the 
+  // array of transitions of the world
+  MFTransition* act = world->_transitions + 1;
+#else
   MFModelTransition trans = {._move = 1};
-  MFTransition act = MFTransitionCreateStatic(world, &trans);
-  if (!MFTransitionIsExpandable(&act)) {
+  MFTransition actStatic = MFTransitionCreateStatic(world, &trans);
+  MFTransition* act = &actStatic;
+#endif
+  if (!MFTransitionIsExpandable(act)) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFTransitionIsExpandable failed");
     PBErrCatch(MiniFrameErr);
   }
-  act._toWorld = world;
-  if (MFTransitionIsExpandable(&act)) {
+  act->_toWorld = world;
+  if (MFTransitionIsExpandable(act)) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFTransitionIsExpandable failed");
     PBErrCatch(MiniFrameErr);
   }
-  act._toWorld = NULL;
+  act->_toWorld = NULL;
   world->_status._pos = world->_status._tgt;
+  world->_isEnd = true;
   world->_transitions[0]._toWorld = world;
-  if (MFTransitionIsExpandable(&act)) {
+  world->_nbEndChild = 1;
+  if (MFTransitionIsExpandable(act)) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFTransitionIsExpandable failed");
     PBErrCatch(MiniFrameErr);
   }
   world->_transitions[0]._toWorld = NULL;
-  MFTransitionFreeStatic(&act);
+  world->_nbEndChild = 0;
+#if MF_COMPACTTRANSITION == false
+  MFTransitionFreeStatic(act);
+#endif
   MFWorldFree(&world);
   printf("UnitTestMFTransitionIsExpandable OK\n");
 }
@@ -98,11 +124,24 @@ void UnitTestMFTransitionGetSet() {
     sprintf(MiniFrameErr->_msg, "MFTransitionToWorld failed");
     PBErrCatch(MiniFrameErr);
   }
+#if MF_COMPACTTRANSITION == false
   if (MFTransitionFromWorld(&act) != &worldFrom) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFTransitionFromWorld failed");
     PBErrCatch(MiniFrameErr);
   }
+#endif
+  MFModelStatus status = {._step = 0, ._pos = 0, ._tgt = 1};
+  MFWorld* world = MFWorldCreate(&status);
+  for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+    if (MFTransitionFromWorld(MFWorldTransition(world, iTrans)) != 
+      world) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFTransitionFromWorld failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  MFWorldFree(&world);
   MFTransitionSetValue(&act, 0, 1.0);
   if (ISEQUALF(act._values[0], 1.0) == false) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
@@ -139,8 +178,11 @@ void UnitTestMFWorldCreateFree() {
   MFModelStatus modelWorld = {._step = 0, ._pos = 0, ._tgt = 1};
   MFWorld* world = MFWorldCreate(&modelWorld);
   if (world == NULL ||
-    GSetNbElem(&(world->_sources)) != 0 ||
-    world->_nbTransition != 3) {
+    world->_nbSource != 0 ||
+    world->_extraSources != NULL ||
+    world->_nbTransition != 3 ||
+    MFWorldIsEnd(world) != false ||
+    MFWorldHasEndChild(world) != false) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFWorldCreate failed");
     PBErrCatch(MiniFrameErr);
@@ -159,6 +201,14 @@ void UnitTestMFWorldCreateFree() {
     sprintf(MiniFrameErr->_msg, "MFWorldFree failed");
     PBErrCatch(MiniFrameErr);
   }
+  MFModelStatus endWorld = {._step = 0, ._pos = 1, ._tgt = 1};
+  world = MFWorldCreate(&endWorld);
+  if (MFWorldIsEnd(world) != true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldCreate failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFWorldFree(&world);
 
   printf("UnitTestMFWorldCreateFree OK\n");
 }
@@ -176,9 +226,9 @@ void UnitTestMFWorldGetSet() {
     sprintf(MiniFrameErr->_msg, "MFWorldGetNbTrans failed");
     PBErrCatch(MiniFrameErr);
   }
-  if (MFWorldSources(world) != &(world->_sources)) {
+  if (MFWorldGetNbSource(world) != world->_nbSource) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
-    sprintf(MiniFrameErr->_msg, "MFWorldSources failed");
+    sprintf(MiniFrameErr->_msg, "MFWorldGetNbSource failed");
     PBErrCatch(MiniFrameErr);
   }
   if (MFWorldValues(world) != world->_values) {
@@ -231,13 +281,333 @@ void UnitTestMFWorldComputeTransition() {
   printf("UnitTestMFWorldComputeTransition OK\n");
 }
 
+void UnitTestMFWorldSources() {
+  MFModelStatus modelWorld = {._step = 0, ._pos = 0, ._tgt = 1};
+  MFWorld* world = MFWorldCreate(&modelWorld);
+  int nbSource = MF_NBINLINESOURCE + 3;
+  MFWorld* from[MF_NBINLINESOURCE + 3];
+  MFTransition* trans[MF_NBINLINESOURCE + 3];
+  for (int iSource = 0; iSource < nbSource; ++iSource) {
+    from[iSource] = MFWorldCreate(&modelWorld);
+    trans[iSource] = (MFTransition*)MFWorldTransition(from[iSource], 0);
+    MFWorldAddSource(world, trans[iSource]);
+  }
+  if (MFWorldGetNbSource(world) != nbSource ||
+    world->_extraSources == NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldAddSource failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  for (int iSource = 0; iSource < nbSource; ++iSource) {
+    if (MFWorldSource(world, iSource) != trans[iSource]) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFWorldSource failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  MFWorldRemoveSource(world, trans[1]);
+  if (MFWorldGetNbSource(world) != nbSource - 1 ||
+    MFWorldSource(world, 0) != trans[0] ||
+    MFWorldSource(world, 1) != trans[2] ||
+    MFWorldSource(world, nbSource - 2) != trans[nbSource - 1]) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldRemoveSource failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFWorldFree(&world);
+  for (int iSource = 0; iSource < nbSource; ++iSource)
+    MFWorldFree(from + iSource);
+  printf("UnitTestMFWorldSources OK\n");
+}
+
+void UnitTestMFWorldPool() {
+  MFWorldPool pool = MFWorldPoolCreateStatic();
+  if (pool._blocks != NULL ||
+    pool._nbUsedInBlock != 0 ||
+    pool._freeWorlds != NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolCreateStatic failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFModelStatus modelWorld = {._step = 0, ._pos = 0, ._tgt = 1};
+  MFWorld* worldA = MFWorldCreateFromPool(&pool, &modelWorld);
+  MFWorld* worldB = MFWorldCreateFromPool(&pool, &modelWorld);
+  if (worldA->_pool != &pool ||
+    worldA != pool._blocks->_worlds ||
+    worldB != pool._blocks->_worlds + 1 ||
+    pool._nbUsedInBlock != 2 ||
+    MFWorldGetNbTrans(worldA) != 3 ||
+    worldA->_transitions != 
+      pool._transBlocks->_transitions + MF_NBTRANSHEADER ||
+    worldB->_transitions != 
+      pool._transBlocks->_transitions + 3 + 2 * MF_NBTRANSHEADER ||
+    pool._nbUsedInTransBlock != 6 + 2 * MF_NBTRANSHEADER) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldCreateFromPool failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFWorld* world = worldA;
+  MFTransition* transitions = worldA->_transitions - MF_NBTRANSHEADER;
+  MFWorldFree(&worldA);
+  if (worldA != NULL || pool._freeWorlds != world ||
+    pool._freeTransitions[3 + MF_NBTRANSHEADER] != transitions) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolRelease failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  worldA = MFWorldPoolAlloc(&pool);
+  if (worldA != world || pool._freeWorlds != NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolAlloc failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  for (int iWorld = MF_NBWORLDPERPOOLBLOCK; iWorld--;)
+    (void)MFWorldPoolAlloc(&pool);
+  if (pool._blocks->_next == NULL || pool._nbUsedInBlock != 2) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolAlloc failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (MFWorldPoolAllocTrans(&pool, 3 + MF_NBTRANSHEADER) != transitions ||
+    pool._freeTransitions[3 + MF_NBTRANSHEADER] != NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolAllocTrans failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  while (pool._transBlocks->_next == NULL)
+    (void)MFWorldPoolAllocTrans(&pool, 3);
+  if (pool._nbUsedInTransBlock != 3) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolAllocTrans failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFWorldPoolFreeStatic(&pool);
+  if (pool._blocks != NULL || pool._transBlocks != NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFWorldPoolFreeStatic failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  printf("UnitTestMFWorldPool OK\n");
+}
+
 void UnitTestMFWorld() {
   UnitTestMFWorldCreateFree();
   UnitTestMFWorldGetSet();
   UnitTestMFWorldComputeTransition();
+  UnitTestMFWorldSources();
+  UnitTestMFWorldPool();
   printf("UnitTestMFWorld OK\n");
 }
 
+void UnitTestMFFrontierPushPop() {
+  // Check the frontier sorted by priority and the unsorted one
+  for (int isSorted = 0; isSorted < 2; ++isSorted) {
+    MFFrontier frontier = MFFrontierCreateStatic(isSorted);
+    if (MFFrontierGetNb(&frontier) != 0) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFFrontierCreateStatic failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    MFModelStatus modelWorld = {._step = 0, ._pos = 0, ._tgt = 1};
+    MFWorld* worlds[3];
+    for (int iWorld = 3; iWorld--;)
+      worlds[iWorld] = MFWorldCreate(&modelWorld);
+    int order[3] = {0, 1, 2};
+    if (isSorted) {
+      MFFrontierPushSort(&frontier, worlds[0], 1.0);
+      MFFrontierPushSort(&frontier, worlds[1], 3.0);
+      MFFrontierPushSort(&frontier, worlds[2], 1.0);
+    } else {
+      MFFrontierPushLast(&frontier, worlds[0]);
+      MFFrontierPushLast(&frontier, worlds[1]);
+      MFFrontierPushNext(&frontier, worlds[2]);
+      order[1] = 2;
+      order[2] = 1;
+    }
+    if (MFFrontierGetNb(&frontier) != 3) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFFrontierPush failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    int iRemove = 0;
+    while (MFFrontierGet(&frontier, iRemove) != worlds[0])
+      ++iRemove;
+    if (MFFrontierRemove(&frontier, iRemove) != worlds[0] ||
+      MFFrontierGetNb(&frontier) != 2) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFFrontierRemove failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    MFFrontierPushNext(&frontier, worlds[0]);
+    if (MFFrontierPeek(&frontier, 0) != worlds[order[0]] ||
+      (!isSorted && (MFFrontierPeek(&frontier, 1) != worlds[order[1]] ||
+      MFFrontierPeek(&frontier, 2) != worlds[order[2]]))) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFFrontierPeek failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    for (int iWorld = 0; iWorld < 3; ++iWorld) {
+      if (MFFrontierPop(&frontier) != worlds[order[iWorld]]) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFFrontierPop failed");
+        PBErrCatch(MiniFrameErr);
+      }
+    }
+    if (isSorted) {
+      for (int iWorld = 0; iWorld <= MF_NBINITFRONTIER; ++iWorld)
+        MFFrontierPushSort(&frontier, worlds[iWorld % 3], 
+          (float)((iWorld * 7) % (MF_NBINITFRONTIER + 1)));
+      for (int iWorld = MF_NBINITFRONTIER; iWorld >= 0; --iWorld) {
+        if (ISEQUALF(frontier._elems[0]._priority, (float)iWorld) == 
+          false) {
+          MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(MiniFrameErr->_msg, "MFFrontierPushSort failed");
+          PBErrCatch(MiniFrameErr);
+        }
+        (void)MFFrontierPop(&frontier);
+      }
+    } else {
+      MFWorld* many = PBErrMalloc(MiniFrameErr, 
+        sizeof(MFWorld) * (MF_NBINITFRONTIER + 1));
+      for (int iWorld = 0; iWorld <= MF_NBINITFRONTIER; ++iWorld) {
+        if (iWorld % 2 == 0)
+          MFFrontierPushLast(&frontier, many + iWorld);
+        else
+          MFFrontierPushNext(&frontier, many + iWorld);
+      }
+      if (MFFrontierGetNb(&frontier) != MF_NBINITFRONTIER + 1 ||
+        frontier._nbAlloc != 2 * MF_NBINITFRONTIER) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFFrontierPush failed");
+        PBErrCatch(MiniFrameErr);
+      }
+      for (int iWorld = MF_NBINITFRONTIER - 1; iWorld > 0; 
+        iWorld -= 2) {
+        if (MFFrontierPop(&frontier) != many + iWorld) {
+          MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(MiniFrameErr->_msg, "MFFrontierPop failed");
+          PBErrCatch(MiniFrameErr);
+        }
+      }
+      for (int iWorld = 0; iWorld <= MF_NBINITFRONTIER; iWorld += 2) {
+        if (MFFrontierPop(&frontier) != many + iWorld) {
+          MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(MiniFrameErr->_msg, "MFFrontierPop failed");
+          PBErrCatch(MiniFrameErr);
+        }
+      }
+      free(many);
+    }
+    if (MFFrontierGetNb(&frontier) != 0) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFFrontierPop failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    MFFrontierFreeStatic(&frontier);
+    for (int iWorld = 3; iWorld--;)
+      MFWorldFree(worlds + iWorld);
+  }
+  printf("UnitTestMFFrontierPushPop OK\n");
+}
+
+void UnitTestMFFrontier() {
+  UnitTestMFFrontierPushPop();
+  printf("UnitTestMFFrontier OK\n");
+}
+
+void UnitTestMFTimeManagerDeadlines() {
+  MFTimeManager tm = MFTimeManagerCreateStatic();
+  MFTimeManagerStart(&tm, MFGetWallClockMs());
+  if (MFTimeManagerGetElapsed(&tm) < 0.0 ||
+    MFTimeManagerIsOver(&tm) == false ||
+    MFTimeManagerHasTimeFor(&tm, 0.0) == true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerCreateStatic failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFTimeManagerSetDeadlines(&tm, 1e6, 2e6);
+  if (MFTimeManagerIsOver(&tm) == true ||
+    MFTimeManagerHasTimeFor(&tm, 1.0) == false ||
+    MFTimeManagerHasTimeFor(&tm, 1e6) == true ||
+    MFTimeManagerGetTimeLeft(&tm) <= 1e6) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerSetDeadlines failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  printf("UnitTestMFTimeManagerDeadlines OK\n");
+}
+
+void UnitTestMFTimeManagerStepCost() {
+  MFTimeManager tm = MFTimeManagerCreateStatic();
+  if (!ISEQUALF(MFTimeManagerGetStepCost(&tm), 0.0)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerGetStepCost failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // The estimation must converge toward a constant cost from above
+  MFTimeManagerAddStepCost(&tm, 2.0);
+  for (int iStep = 1000; iStep--;)
+    MFTimeManagerAddStepCost(&tm, 1.0);
+  if (MFTimeManagerGetStepCost(&tm) < 0.9 ||
+    MFTimeManagerGetStepCost(&tm) > 1.1) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerAddStepCost failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFTimeManagerResetStepCost(&tm);
+  if (!ISEQUALF(MFTimeManagerGetStepCost(&tm), 0.0)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerResetStepCost failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  printf("UnitTestMFTimeManagerStepCost OK\n");
+}
+
+void UnitTestMFTimeManagerStability() {
+  MFTimeManager tm = MFTimeManagerCreateStatic();
+  MFTimeManagerSetBudget(&tm, 10.0, 20.0);
+  if (!ISEQUALF(tm._softDeadline, 10.0) ||
+    !ISEQUALF(tm._hardDeadline, 20.0)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerSetBudget failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // A stable best transition reduces the soft deadline down to its 
+  // minimum
+  for (int iCheck = 20; iCheck--;)
+    MFTimeManagerCheckStability(&tm, 0, 1.0);
+  if (!ISEQUALF(tm._softDeadline, 10.0 * MF_GAMECLOCKMINFACTOR)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerCheckStability failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // A change of best transition and its value extends it, within the
+  // hard deadline
+  MFTimeManagerCheckStability(&tm, 1, 1.0 + MF_GAMECLOCKVOLATILITYSCALE);
+  if (tm._softDeadline <= 10.0 * MF_GAMECLOCKINSTABILITYFACTOR ||
+    tm._softDeadline > 20.0) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerCheckStability failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // Fixed deadlines are not adjusted
+  MFTimeManagerSetDeadlines(&tm, 5.0, 5.0);
+  MFTimeManagerCheckStability(&tm, 0, 1.0);
+  if (!ISEQUALF(tm._softDeadline, 5.0)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTimeManagerCheckStability failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  printf("UnitTestMFTimeManagerStability OK\n");
+}
+
+void UnitTestMFTimeManager() {
+  UnitTestMFTimeManagerDeadlines();
+  UnitTestMFTimeManagerStepCost();
+  UnitTestMFTimeManagerStability();
+  printf("UnitTestMFTimeManager OK\n");
+}
+
 void UnitTestMiniFrameCreateFree() {
   MFModelStatus initStatus = {._step = 0, ._pos = 0, ._tgt = 1};
   MiniFrame* mf = MiniFrameCreate(&initStatus);
@@ -245,13 +615,16 @@ void UnitTestMiniFrameCreateFree() {
     mf->_nbStep != 0 ||
     ISEQUALF(mf->_maxTimeExpansion, MF_DEFAULTTIMEEXPANSION) == false ||
     MFModelStatusIsSame(&initStatus, &(MFCurWorld(mf)->_status)) == false ||
-    GSetNbElem(MFWorldsToExpand(mf)) != 1 ||
-    MFCurWorld(mf) != GSetGet(MFWorldsToExpand(mf), 0) ||
+    MFFrontierGetNb(MFWorldsToExpand(mf)) != 1 ||
+    MFCurWorld(mf) != MFFrontierGet(MFWorldsToExpand(mf), 0) ||
     ISEQUALF(mf->_timeUnusedExpansion, 0.0) == false ||
     ISEQUALF(mf->_percWorldReused, 0.0) == false ||
     mf->_maxDepthExp != MF_DEFAULTMAXDEPTHEXP ||
     mf->_pruningDeltaVal != MF_PRUNINGDELTAVAL ||
-    mf->_reuseWorld != false) {
+    mf->_reuseWorld != false ||
+    mf->_nbWorldsHash != 1 ||
+    MFCurWorld(mf)->_pool != &(mf->_worldPool) ||
+    mf->_nbBucketWorldsHash != MF_NBWORLDHASHBUCKET) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MiniFrameCreate failed");
     PBErrCatch(MiniFrameErr);
@@ -322,7 +695,7 @@ void UnitTestMiniFrameGetSet() {
   }
   MFWorld* worldToExpand = MFWorldCreate(&modelWorld);
   MFAddWorldToExpand(mf, worldToExpand);
-  if (GSetNbElem(MFWorldsToExpand(mf)) != 2) {
+  if (MFFrontierGetNb(MFWorldsToExpand(mf)) != 2) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFAddWorldToExpand failed");
     PBErrCatch(MiniFrameErr);
@@ -381,6 +754,51 @@ void UnitTestMiniFrameGetSet() {
     sprintf(MiniFrameErr->_msg, "MFSetPruningDeltaVal failed");
     PBErrCatch(MiniFrameErr);
   }
+  if (MFGetNbExpansionPerBackprop(mf) != mf->_nbExpansionPerBackprop) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFGetNbExpansionPerBackprop failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetNbExpansionPerBackprop(mf, 4);
+  if (MFGetNbExpansionPerBackprop(mf) != 4) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbExpansionPerBackprop failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetNbExpansionPerBackprop(mf, 0);
+  if (MFGetNbExpansionPerBackprop(mf) != 1) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbExpansionPerBackprop failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (MFGetNbThread(mf) != mf->_nbThread) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFGetNbThread failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetNbThread(mf, 4);
+  if (MFGetNbThread(mf) != 4) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbThread failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetNbThread(mf, 0);
+  if (MFGetNbThread(mf) != 1) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbThread failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (MFIsTreeParallel(mf) != mf->_treeParallel) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFIsTreeParallel failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetTreeParallel(mf, true);
+  if (MFIsTreeParallel(mf) != true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetTreeParallel failed");
+    PBErrCatch(MiniFrameErr);
+  }
   MiniFrameFree(&mf);
   printf("UnitTestMiniFrameGetSet OK\n");
 }
@@ -405,6 +823,8 @@ void UnitTestMiniFrameExpandSetCurWorld() {
   if (mf->_timeUnusedExpansion < 0.0 ||
     MFGetNbComputedWorlds(mf) != 13 ||
     MFGetNbWorldsToExpand(mf) != 0 ||
+    mf->_nbWorldsHash != 
+      MFGetNbComputedWorlds(mf) + MFGetNbWorldsToExpand(mf) ||
     ISEQUALF(MFGetPercWorldReused(mf), 0.666667) == false) {
     MiniFrameErr->_type = PBErrTypeUnitTestFailed;
     sprintf(MiniFrameErr->_msg, "MFExpand failed");
@@ -439,6 +859,755 @@ void UnitTestMiniFrameExpandSetCurWorld() {
   printf("UnitTestMiniFrameExpandSetCurWorld OK\n");
 }
 
+void UnitTestMiniFrameCheckWorldCache(const MiniFrame* const mf) {
+  GSetIterForward iter = 
+    GSetIterForwardCreateStatic(MFWorldsComputed(mf));
+  do {
+    MFWorld* world = GSetIterGet(&iter);
+    int sente = MFModelStatusGetSente(MFWorldStatus(world));
+    const MFTransition* bestTrans = NULL;
+    for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+      const MFTransition* trans = MFWorldTransition(world, iTrans);
+      if (MFTransitionIsExpanded(trans) && (bestTrans == NULL ||
+        MFTransitionGetValue(bestTrans, sente) < 
+        MFTransitionGetValue(trans, sente)))
+        bestTrans = trans;
+    }
+    float val = (bestTrans == NULL ? MFWorldGetValue(world, 0) : 
+      MFTransitionGetValue(bestTrans, 0));
+    if (ISEQUALF(MFWorldGetForecastValue(world, 0), val) == false) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFWorldGetForecastValue failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    bool hasEndChild = false;
+    for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+      const MFWorld* child = 
+        MFTransitionToWorld(MFWorldTransition(world, iTrans));
+      if (child != NULL && MFModelStatusIsEnd(MFWorldStatus(child)))
+        hasEndChild = true;
+    }
+    if (MFWorldIsEnd(world) != MFModelStatusIsEnd(MFWorldStatus(world)) ||
+      MFWorldHasEndChild(world) != hasEndChild) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFWorldHasEndChild failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  } while (GSetIterStep(&iter));
+}
+
+void UnitTestMiniFrameCheckForecastValues(const GSet* const worlds) {
+  GSetIterForward iter = GSetIterForwardCreateStatic(worlds);
+  do {
+    MFWorld* world = GSetIterGet(&iter);
+    for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+      const MFTransition* trans = MFWorldTransition(world, iTrans);
+      if (MFTransitionIsExpanded(trans) && 
+        fabs(MFTransitionGetValue(trans, 0) - MFWorldGetForecastValue(
+        MFTransitionToWorld(trans), 0)) > 0.001) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFTransitionGetValue failed");
+        PBErrCatch(MiniFrameErr);
+      }
+    }
+  } while (GSetIterStep(&iter));
+}
+
+void UnitTestMiniFrameTransposition() {
+  // Create the graph R->P, P->A, P->B, A->W, B->W, A->A2 where W is
+  // reached through two paths
+  MFModelStatus status = {._step = 0, ._pos = 0, ._tgt = 5};
+  MiniFrame* mf = MiniFrameCreate(&status);
+  MFWorld* worldR = MFWorldCreate(&status);
+  MFWorld* worldP = MFWorldCreate(&status);
+  MFWorld* worldA = MFWorldCreate(&status);
+  MFWorld* worldB = MFWorldCreate(&status);
+  MFWorld* worldW = MFWorldCreate(&status);
+  MFWorld* worldA2 = MFWorldCreate(&status);
+  float values[MF_NBMAXACTOR] = {10.0};
+  MFWorldSetValues(worldW, values);
+  values[0] = 5.0;
+  MFWorldSetValues(worldA2, values);
+  MFWorldSetTransitionToWorld(worldA, 0, worldW);
+  MFWorldSetTransitionToWorld(worldA, 1, worldA2);
+  MFWorldSetTransitionToWorld(worldB, 0, worldW);
+  MFWorldSetTransitionToWorld(worldP, 0, worldA);
+  MFWorldSetTransitionToWorld(worldP, 1, worldB);
+  MFWorldSetTransitionToWorld(worldR, 0, worldP);
+  GSet worlds = GSetCreateStatic();
+  GSetAppend(&worlds, worldR);
+  GSetAppend(&worlds, worldP);
+  GSetAppend(&worlds, worldA);
+  GSetAppend(&worlds, worldB);
+  GSetAppend(&worlds, worldW);
+  GSetAppend(&worlds, worldA2);
+  UnitTestMiniFrameCheckForecastValues(&worlds);
+  // Drop the value of W, the update through A reaches P before the
+  // one through B, which must update P again
+  values[0] = 1.0;
+  MFWorldSetValues(worldW, values);
+  MFUpdateForecastValues(mf, worldW);
+  UnitTestMiniFrameCheckForecastValues(&worlds);
+  if (fabs(MFWorldGetForecastValue(worldR, 0) - 5.0) > 0.001) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFUpdateForecastValues failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  float forecastR = MFWorldGetForecastValue(worldR, 0);
+  // Same by batch, with B less deep than P as if it was reused, P is
+  // updated before the update through B reaches it
+  values[0] = 10.0;
+  MFWorldSetValues(worldW, values);
+  MFUpdateForecastValues(mf, worldW);
+  worldR->_depth = 0;
+  worldB->_depth = 1;
+  worldP->_depth = 2;
+  worldA->_depth = 3;
+  worldW->_depth = 4;
+  values[0] = 1.0;
+  MFWorldSetValues(worldW, values);
+  MFMarkWorldDirty(mf, worldW);
+  MFUpdateDirtyForecastValues(mf);
+  UnitTestMiniFrameCheckForecastValues(&worlds);
+  if (mf->_nbDirtyWorld != 0 ||
+    !ISEQUALF(MFWorldGetForecastValue(worldR, 0), forecastR)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFUpdateDirtyForecastValues failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  GSetFlush(&worlds);
+  MFWorldFree(&worldR);
+  MFWorldFree(&worldP);
+  MFWorldFree(&worldA);
+  MFWorldFree(&worldB);
+  MFWorldFree(&worldW);
+  MFWorldFree(&worldA2);
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameTransposition OK\n");
+}
+
+void UnitTestMiniFrameBestTransition() {
+  MFModelStatus initWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&initWorld);
+  MFSetStartExpandClock(mf, clock());
+  MFSetWorldReusable(mf, true);
+  MFExpand(mf);
+  UnitTestMiniFrameCheckWorldCache(mf);
+  MFModelStatus nextWorld = {._step = 1, ._pos = -1, ._tgt = 2};
+  MFSetCurWorld(mf, &nextWorld);
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  UnitTestMiniFrameCheckWorldCache(mf);
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameBestTransition OK\n");
+}
+
+void UnitTestMiniFrameBatchBackprop() {
+  MFModelStatus initWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&initWorld);
+  MiniFrame* mfBatch = MiniFrameCreate(&initWorld);
+  MFSetWorldReusable(mf, true);
+  MFSetWorldReusable(mfBatch, true);
+  MFSetNbExpansionPerBackprop(mfBatch, 4);
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  MFSetStartExpandClock(mfBatch, clock());
+  MFExpand(mfBatch);
+  if (mfBatch->_nbDirtyWorld != 0) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  UnitTestMiniFrameCheckWorldCache(mfBatch);
+  if (MFGetNbComputedWorlds(mf) != MFGetNbComputedWorlds(mfBatch)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // The forecast values of each world are the ones per expansion, 
+  // except for the penalties which are far smaller than the distances
+  // to the target, the values of the model
+  GSetIterForward iter = 
+    GSetIterForwardCreateStatic(MFWorldsComputed(mfBatch));
+  do {
+    MFWorld* world = GSetIterGet(&iter);
+    MFWorld* worldPerExp = MFSearchWorld(mf, MFWorldStatus(world), NULL);
+    if (worldPerExp == NULL ||
+      ISEQUALF(roundf(MFWorldGetForecastValue(world, 0)), 
+      roundf(MFWorldGetForecastValue(worldPerExp, 0))) == false) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFUpdateDirtyForecastValues failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  } while (GSetIterStep(&iter));
+  MiniFrameFree(&mf);
+  MiniFrameFree(&mfBatch);
+  printf("UnitTestMiniFrameBatchBackprop OK\n");
+}
+
+void UnitTestMiniFrameParallelExpansion() {
+  MFModelStatus initWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&initWorld);
+  MiniFrame* mfParallel = MiniFrameCreate(&initWorld);
+  MFSetWorldReusable(mf, true);
+  MFSetWorldReusable(mfParallel, true);
+  MFSetNbThread(mfParallel, 3);
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  MFSetStartExpandClock(mfParallel, clock());
+  MFExpand(mfParallel);
+  if (mfParallel->_nbThreadPool != 2) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  UnitTestMiniFrameCheckWorldCache(mfParallel);
+  // With reuse on, the parallel expansion doesn't evaluate the worlds 
+  // which would be reused, as the serial one
+  if (MFGetNbComputedWorlds(mf) != MFGetNbComputedWorlds(mfParallel) ||
+    mf->_work._nbEvaluation != mfParallel->_work._nbEvaluation ||
+    fabs(MFWorldGetForecastValue(MFCurWorld(mf), 0) - 
+    MFWorldGetForecastValue(MFCurWorld(mfParallel), 0)) > 0.001) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  MiniFrameFree(&mfParallel);
+  printf("UnitTestMiniFrameParallelExpansion OK\n");
+}
+
+void UnitTestMiniFramePondering() {
+  MFModelStatus initWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&initWorld);
+  if (MFIsPondering(mf) != false) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFIsPondering failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFStartPondering(mf);
+  if (MFIsPondering(mf) != true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFStartPondering failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  struct timespec delay = {.tv_sec = 0, .tv_nsec = 10000000};
+  nanosleep(&delay, NULL);
+  MFStopPondering(mf);
+  if (MFIsPondering(mf) != false ||
+    MFGetNbComputedWorlds(mf) == 0) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFStopPondering failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  UnitTestMiniFrameCheckWorldCache(mf);
+  MFStartPondering(mf);
+  MFModelStatus status = {._step = 1, ._pos = 1, ._tgt = 2};
+  MFSetCurWorld(mf, &status);
+  if (MFIsPondering(mf) != false ||
+    MFModelStatusIsSame(&status, MFWorldStatus(MFCurWorld(mf))) == false) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetCurWorld failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFramePondering OK\n");
+}
+
+// Return the nb of playouts through the transitions of the MFWorld 
+// 'world' in the tree of the MCTS
+long UnitTestMiniFrameMCTSNbVisit(const MFWorld* const world) {
+  long nbVisit = 0;
+  if (world->_mctsStats != NULL)
+    for (int iTrans = MFWorldGetNbTrans(world); iTrans--;)
+      nbVisit += world->_mctsStats[iTrans]._nbVisit;
+  return nbVisit;
+}
+
+// Return the nb of worlds in the subtree of the MCTS from the MFWorld
+// 'world'
+int UnitTestMiniFrameMCTSNbWorld(const MFWorld* const world) {
+  int nbWorld = 1;
+  for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+    const MFWorld* toWorld = 
+      MFTransitionToWorld(MFWorldTransition(world, iTrans));
+    if (toWorld != NULL)
+      nbWorld += UnitTestMiniFrameMCTSNbWorld(toWorld);
+  }
+  return nbWorld;
+}
+
+void UnitTestMiniFrameMCTS() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  MFSetExpansionType(mf, MFExpansionTypeMCTS);
+  MFSetMaxTimeExpansion(mf, 10.0);
+  // The statistics of the tree are kept from one expansion to the next
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  long nbVisit = UnitTestMiniFrameMCTSNbVisit(MFCurWorld(mf));
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  if (nbVisit == 0 || 
+    UnitTestMiniFrameMCTSNbVisit(MFCurWorld(mf)) <= nbVisit ||
+    MFGetNbComputedWorlds(mf) != 
+    UnitTestMiniFrameMCTSNbWorld(MFCurWorld(mf))) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // Moving to the world of the best transition keeps its subtree and 
+  // statistics, and frees the other worlds
+  int depth = MFCurWorld(mf)->_depth;
+  const MFModelTransition* bestTrans = MFBestTransition(mf, 0);
+  const MFWorld* nextWorld = NULL;
+  for (int iTrans = MFWorldGetNbTrans(MFCurWorld(mf)); iTrans--;) {
+    const MFTransition* trans = 
+      MFWorldTransition(MFCurWorld(mf), iTrans);
+    if (&(trans->_transition) == bestTrans)
+      nextWorld = MFTransitionToWorld(trans);
+  }
+  nbVisit = UnitTestMiniFrameMCTSNbVisit(nextWorld);
+  int nbWorld = UnitTestMiniFrameMCTSNbWorld(nextWorld);
+  curWorld = MFModelStatusStep(&curWorld, bestTrans);
+  MFSetCurWorld(mf, &curWorld);
+  if (MFCurWorld(mf) != nextWorld || 
+    MFWorldGetNbSource(nextWorld) != 0 ||
+    UnitTestMiniFrameMCTSNbVisit(nextWorld) != nbVisit ||
+    MFGetNbComputedWorlds(mf) != nbWorld ||
+    MFCurWorld(mf)->_depth != depth + 1) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetCurWorld failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // Moving to a world out of the tree, as the target has moved, frees
+  // it and creates a new one whose depth follows the one of the 
+  // current world
+  curWorld._tgt = -1;
+  MFSetCurWorld(mf, &curWorld);
+  if (MFModelStatusIsSame(MFWorldStatus(MFCurWorld(mf)), 
+    &curWorld) == false ||
+    MFGetNbComputedWorlds(mf) != 1 ||
+    UnitTestMiniFrameMCTSNbVisit(MFCurWorld(mf)) != 0 ||
+    MFCurWorld(mf)->_depth != depth + 2) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetCurWorld failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameMCTS OK\n");
+}
+
+void UnitTestMiniFrameMCTSThreads() {
+  // Play the game by MCTS with several threads, searching their own 
+  // tree and then the same tree
+  for (int isTreeParallel = 0; isTreeParallel < 2; ++isTreeParallel) {
+    MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+    MiniFrame* mf = MiniFrameCreate(&curWorld);
+    MFSetExpansionType(mf, MFExpansionTypeMCTS);
+    MFSetNbThread(mf, 4);
+    MFSetTreeParallel(mf, isTreeParallel);
+    MFSetMaxTimeExpansion(mf, 20.0);
+    int tgt[7] = {2,2,-1,-1,-1,-1,-1};
+    for (int iStep = 0; !MFModelStatusIsEnd(&curWorld) && iStep < 5;
+      ++iStep) {
+      MFSetCurWorld(mf, &curWorld);
+      MFSetStartExpandClock(mf, clock());
+      MFExpand(mf);
+      // There is a best transition, and the playouts of all the 
+      // threads are counted in the tree of the current world
+      // The quality of the move is not checked, as the statuses of the
+      // example are the same at any step and the kept subtree may 
+      // have been searched with another nb of steps left
+      const MFModelTransition* bestTrans = MFBestTransition(mf, 0);
+      if (bestTrans == NULL || 
+        UnitTestMiniFrameMCTSNbVisit(MFCurWorld(mf)) == 0) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFExpand failed (tree parallel %d)",
+          isTreeParallel);
+        PBErrCatch(MiniFrameErr);
+      }
+      curWorld = MFModelStatusStep(&curWorld, bestTrans);
+      curWorld._tgt = tgt[curWorld._step];
+    }
+    MiniFrameFree(&mf);
+  }
+  printf("UnitTestMiniFrameMCTSThreads OK\n");
+}
+
+// Return the value of the MFModelStatus 'status' for the actor 
+// 'iActor' searched by plain minimax up to 'depth' transitions
+float UnitTestMiniFrameMinimax(const MFModelStatus* const status,
+  const int depth, const int iActor) {
+  MFModelTransition transitions[MF_NBMAXTRANSITION];
+  int nbTrans = 0;
+  if (!MFModelStatusIsEnd(status) && depth > 0)
+    MFModelStatusGetTrans(status, transitions, &nbTrans);
+  if (nbTrans == 0) {
+    float values[MF_NBMAXACTOR] = {0.0};
+    MFModelStatusGetValues(status, values);
+    return values[iActor];
+  }
+  bool isMax = (MFModelStatusGetSente(status) == iActor);
+  float best = (isMax ? -FLT_MAX : FLT_MAX);
+  for (int iTrans = 0; iTrans < nbTrans; ++iTrans) {
+    MFModelStatus res = MFModelStatusStepEnd(status);
+    res = MFModelStatusStep(&res, transitions + iTrans);
+    res = MFModelStatusStepInit(&res);
+    float val = UnitTestMiniFrameMinimax(&res, depth - 1, iActor);
+    MFModelStatusFreeStatic(&res);
+    if ((isMax && best < val) || (!isMax && best > val))
+      best = val;
+    MFModelTransitionFreeStatic(transitions + iTrans);
+  }
+  return best;
+}
+
+void UnitTestMiniFrameAlphaBeta() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 3};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  MFSetExpansionType(mf, MFExpansionTypeAlphaBeta);
+  MFSetMaxTimeExpansion(mf, FLT_MAX);
+  // Play the game, the best transition and its value must be the ones
+  // of a plain minimax at the same depth, searched twice to check the
+  // order given by the table of best transitions
+  int depth = 3;
+  MFSetMaxDepthExp(mf, depth);
+  int tgt[7] = {3,3,-2,-2,-2,-2,-2};
+  while (!MFModelStatusIsEnd(&curWorld)) {
+    for (int iSearch = 0; iSearch < 2; ++iSearch) {
+      MFSetStartExpandClock(mf, clock());
+      MFExpand(mf);
+      const MFWorld* world = MFCurWorld(mf);
+      int iBestTrans = world->_iBestTrans[0];
+      if (iBestTrans == -1) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFExpand failed");
+        PBErrCatch(MiniFrameErr);
+      }
+      MFModelStatus res = MFWorldComputeTransition(world, iBestTrans);
+      float val = MFTransitionGetValue(
+        MFWorldTransition(world, iBestTrans), 0);
+      if (ISEQUALF(val, 
+        UnitTestMiniFrameMinimax(&curWorld, depth, 0)) == false ||
+        ISEQUALF(val, 
+        UnitTestMiniFrameMinimax(&res, depth - 1, 0)) == false) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFExpand failed");
+        PBErrCatch(MiniFrameErr);
+      }
+      MFModelStatusFreeStatic(&res);
+    }
+    const MFModelTransition* bestTrans = MFBestTransition(mf, 0);
+    curWorld = MFModelStatusStep(&curWorld, bestTrans);
+    curWorld._tgt = tgt[curWorld._step];
+    // The depth of the current world follows the steps of the game
+    int depthCurWorld = MFCurWorld(mf)->_depth;
+    MFSetCurWorld(mf, &curWorld);
+    if (MFCurWorld(mf)->_depth != depthCurWorld + 1) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFSetCurWorld failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameAlphaBeta OK\n");
+}
+
+void UnitTestMiniFrameExpansionType() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  if (MFGetExpansionType(mf) != (MFExpansionType)MF_EXPANSIONTYPE) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFGetExpansionType failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // Play the game switching the expansion type at each step
+  int tgt[7] = {2,2,-1,-1,-1,-1,-1};
+  MFExpansionType types[5] = {MFExpansionTypeMCTS, 
+    MFExpansionTypeValue, MFExpansionTypeAlphaBeta, 
+    MFExpansionTypeDepthRandomWalk, MFExpansionTypeWidth};
+  for (int iStep = 0; !MFModelStatusIsEnd(&curWorld) && iStep < 5;
+    ++iStep) {
+    MFSetCurWorld(mf, &curWorld);
+    MFSetExpansionType(mf, types[iStep]);
+    if (MFGetExpansionType(mf) != types[iStep] ||
+      MFModelStatusIsSame(&curWorld, 
+        MFWorldStatus(MFCurWorld(mf))) == false ||
+      MFGetNbComputedWorlds(mf) + MFGetNbWorldsToExpand(mf) !=
+        (types[iStep] == MFExpansionTypeAlphaBeta ? 0 : 1)) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFSetExpansionType failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    MFSetStartExpandClock(mf, clock());
+    MFExpand(mf);
+    const MFModelTransition* bestTrans = MFBestTransition(mf, 0);
+    if (bestTrans == NULL) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFExpand failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    curWorld = MFModelStatusStep(&curWorld, bestTrans);
+    curWorld._tgt = tgt[curWorld._step];
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameExpansionType OK\n");
+}
+
+void UnitTestMiniFramePV() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  MFExpansionType types[5] = {MFExpansionTypeValue, 
+    MFExpansionTypeWidth, MFExpansionTypeDepthRandomWalk, 
+    MFExpansionTypeMCTS, MFExpansionTypeAlphaBeta};
+  for (int iType = 0; iType < 5; ++iType) {
+    MFSetExpansionType(mf, types[iType]);
+    MFSetCurWorld(mf, &curWorld);
+    // Expand twice to check the principal variation is still correct
+    // after the updates made while expanding
+    for (int iExpand = 0; iExpand < 2; ++iExpand) {
+      MFSetStartExpandClock(mf, clock());
+      MFExpand(mf);
+      int length = -1;
+      const MFTransition* const* pv = MFGetPV(mf, 0, &length);
+      // Walk the best story from the current world and compare it to
+      // the principal variation
+      const MFWorld* world = MFCurWorld(mf);
+      int iTrans = 0;
+      while (world != NULL && !MFWorldIsEnd(world) && 
+        world->_iBestTrans[0] != -1 && iTrans < length) {
+        const MFTransition* trans = 
+          world->_transitions + world->_iBestTrans[0];
+        if (pv[iTrans] != trans) {
+          MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(MiniFrameErr->_msg, "MFGetPV failed");
+          PBErrCatch(MiniFrameErr);
+        }
+        world = MFTransitionToWorld(trans);
+        ++iTrans;
+      }
+      if (length < 1 || iTrans != length || 
+        (world != NULL && !MFWorldIsEnd(world) && 
+        world->_iBestTrans[0] != -1 && 
+        mf->_pvWorlds[world->_iPV] != world)) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFGetPV failed");
+        PBErrCatch(MiniFrameErr);
+      }
+      // The principal variation is not rebuilt if nothing changed
+      int lengthAgain = -1;
+      if (mf->_isPVValid == false || 
+        MFGetPV(mf, 0, &lengthAgain) != pv || lengthAgain != length) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFGetPV failed");
+        PBErrCatch(MiniFrameErr);
+      }
+    }
+  }
+  MFSetCurWorld(mf, &curWorld);
+  if (mf->_isPVValid == true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetCurWorld failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFramePV OK\n");
+}
+
+void UnitTestMiniFrameMultiPV() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  MFSetNbMultiPV(mf, 0);
+  if (MFGetNbMultiPV(mf) != 1) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbMultiPV failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetNbMultiPV(mf, 2);
+  if (MFGetNbMultiPV(mf) != 2) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetNbMultiPV failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFExpansionType types[3] = {MFExpansionTypeWidth, 
+    MFExpansionTypeMCTS, MFExpansionTypeAlphaBeta};
+  for (int iType = 0; iType < 3; ++iType) {
+    MFSetExpansionType(mf, types[iType]);
+    MFSetCurWorld(mf, &curWorld);
+    const MFTransition* transitions[MF_NBMAXTRANSITION + 1];
+    if (MFGetBestTransitions(mf, 0, 2, transitions) != 0) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFGetBestTransitions failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    MFSetStartExpandClock(mf, clock());
+    MFExpand(mf);
+    // All the transitions from the initial world are ranked
+    int nb = MFGetBestTransitions(mf, 0, MF_NBMAXTRANSITION + 1, 
+      transitions);
+    if (nb != MF_NBMAXTRANSITION || 
+      transitions[0] != (const MFTransition*)MFBestTransition(mf, 0)) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFGetBestTransitions failed");
+      PBErrCatch(MiniFrameErr);
+    }
+    for (int iTrans = 1; iTrans < nb; ++iTrans) {
+      if (MFTransitionGetValue(transitions[iTrans - 1], 0) < 
+        MFTransitionGetValue(transitions[iTrans], 0)) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFGetBestTransitions failed");
+        PBErrCatch(MiniFrameErr);
+      }
+    }
+    // Only the requested nb of transitions are returned
+    const MFTransition* bestTransitions[2];
+    if (MFGetBestTransitions(mf, 0, 2, bestTransitions) != 2 ||
+      bestTransitions[0] != transitions[0] || 
+      bestTransitions[1] != transitions[1]) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFGetBestTransitions failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameMultiPV OK\n");
+}
+
+void UnitTestMiniFrameGameClock() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  MFSetGameClock(mf, 1000.0, 10.0);
+  if (MFUsesGameClock(mf) == false ||
+    !ISEQUALF(MFGetGameClockTimeLeft(mf), 1000.0) ||
+    !ISEQUALF(mf->_gameClockIncrement, 10.0)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetGameClock failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // The expansion is allocated a budget from the time left and the 
+  // increment, within a share of the time left and a multiple of the
+  // budget
+  double timeLeft = 1000.0 - MF_GAMECLOCKMARGIN;
+  double budget = timeLeft / MF_GAMECLOCKNBMOVE + 10.0;
+  double hard = MIN(budget * MF_GAMECLOCKMAXFACTOR, 
+    timeLeft * MF_GAMECLOCKMAXSHARE + 10.0);
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  if (!ISEQUALF(mf->_timeManager._hardDeadline, hard) ||
+    mf->_timeManager._softDeadline > hard ||
+    !ISEQUALF(mf->_avgNbTrans, 3.0) ||
+    MFGetGameClockTimeLeft(mf) > 1010.0 ||
+    MFGetGameClockTimeLeft(mf) < 1010.0 - 2.0 * hard ||
+    MFBestTransition(mf, 0) == NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFExpand failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MFSetMaxTimeExpansion(mf, 10.0);
+  if (MFUsesGameClock(mf) == true) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetMaxTimeExpansion failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameGameClock OK\n");
+}
+
+void UnitTestMiniFrameExpansionBudget() {
+  MFExpansionType types[5] = {MFExpansionTypeValue, 
+    MFExpansionTypeWidth, MFExpansionTypeDepthRandomWalk, 
+    MFExpansionTypeMCTS, MFExpansionTypeAlphaBeta};
+  for (int iType = 0; iType < 5; ++iType) {
+    // Expand twice the same world with the same budget, without time
+    // limit
+    MFExpansionWork works[2];
+    for (int iRun = 0; iRun < 2; ++iRun) {
+      srand(0);
+      MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+      MiniFrame* mf = MiniFrameCreate(&curWorld);
+      MFSetExpansionType(mf, types[iType]);
+      MFSetMaxTimeExpansion(mf, FLT_MAX);
+      MFSetExpansionBudget(mf, 5, 50, 20);
+      if (MFGetExpansionBudget(mf)->_nbExpandedWorld != 5 ||
+        MFGetExpansionBudget(mf)->_nbEvaluation != 50 ||
+        MFGetExpansionBudget(mf)->_nbPlayout != 20) {
+        MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(MiniFrameErr->_msg, "MFSetExpansionBudget failed");
+        PBErrCatch(MiniFrameErr);
+      }
+      MFSetStartExpandClock(mf, clock());
+      MFExpand(mf);
+      works[iRun] = *MFGetExpansionWork(mf);
+      MiniFrameFree(&mf);
+    }
+    // The budget is reached and the work is reproducible
+    if (MFExpansionWorkIsWithin(works, &((MFExpansionWork){
+      ._nbExpandedWorld = 5, ._nbEvaluation = 50, 
+      ._nbPlayout = 20})) ||
+      works[0]._nbExpandedWorld != works[1]._nbExpandedWorld ||
+      works[0]._nbEvaluation != works[1]._nbEvaluation ||
+      works[0]._nbPlayout != works[1]._nbPlayout ||
+      works[0]._nbEvaluation > 50 + MF_NBMAXTRANSITION) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFExpand failed (type %d)", iType);
+      PBErrCatch(MiniFrameErr);
+    }
+    // The MCTS evaluates each world added to the tree, and only the
+    // status reached by each playout
+    if (types[iType] == MFExpansionTypeMCTS &&
+      works[0]._nbEvaluation !=
+        works[0]._nbExpandedWorld + works[0]._nbPlayout) {
+      MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(MiniFrameErr->_msg, "MFMCTSTreePlayout failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  printf("UnitTestMiniFrameExpansionBudget OK\n");
+}
+
+void UnitTestMiniFrameSettled() {
+  MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
+  MiniFrame* mf = MiniFrameCreate(&curWorld);
+  if (!ISEQUALF(MFGetSettledMargin(mf), MF_DEFAULTSETTLEDMARGIN)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFGetSettledMargin failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // Without margin the MCTS stops as soon as the best transition has
+  // been stable long enough, and reports the time saved
+  srand(0);
+  MFSetExpansionType(mf, MFExpansionTypeMCTS);
+  MFSetMaxTimeExpansion(mf, 1000.0);
+  MFSetSettledMargin(mf, 0.0);
+  MFSetStartExpandClock(mf, clock());
+  MFExpand(mf);
+  if (!ISEQUALF(MFGetSettledMargin(mf), 0.0) ||
+    MFGetTimeUnusedExpansion(mf) < 500.0 ||
+    MFGetExpansionWork(mf)->_nbPlayout < 
+      MF_NBSTABLECHECKSETTLED * MF_NBSTEPPERSTABILITYCHECK ||
+    MFBestTransition(mf, 0) == NULL) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFSetSettledMargin failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  // The margin ignores the alternatives proven lower, and is maximum 
+  // without alternative
+  float values[3] = {1.0, 3.0, 2.0};
+  bool isProven[3] = {false, false, true};
+  if (!ISEQUALF(MFTransitionsGetMargin(3, values, isProven, 1), 2.0) ||
+    !ISEQUALF(MFTransitionsGetMargin(1, values, isProven, 0), 
+      FLT_MAX) ||
+    !ISEQUALF(MFTransitionsGetMargin(3, values, isProven, -1), 
+      -FLT_MAX)) {
+    MiniFrameErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(MiniFrameErr->_msg, "MFTransitionsGetMargin failed");
+    PBErrCatch(MiniFrameErr);
+  }
+  MiniFrameFree(&mf);
+  printf("UnitTestMiniFrameSettled OK\n");
+}
+
 void UnitTestMiniFrameFullExample() {
   // Initial world
   MFModelStatus curWorld = {._step = 0, ._pos = 0, ._tgt = 2};
@@ -482,6 +1651,20 @@ void UnitTestMiniFrame() {
   UnitTestMiniFrameCreateFree();
   UnitTestMiniFrameGetSet();
   UnitTestMiniFrameExpandSetCurWorld();
+  UnitTestMiniFrameBestTransition();
+  UnitTestMiniFrameTransposition();
+  UnitTestMiniFrameBatchBackprop();
+  UnitTestMiniFrameParallelExpansion();
+  UnitTestMiniFramePondering();
+  UnitTestMiniFrameExpansionType();
+  UnitTestMiniFrameMCTS();
+  UnitTestMiniFrameMCTSThreads();
+  UnitTestMiniFrameAlphaBeta();
+  UnitTestMiniFramePV();
+  UnitTestMiniFrameMultiPV();
+  UnitTestMiniFrameGameClock();
+  UnitTestMiniFrameExpansionBudget();
+  UnitTestMiniFrameSettled();
   UnitTestMiniFrameFullExample();
   printf("UnitTestMiniFrame OK\n");
 }
@@ -489,6 +1672,8 @@ void UnitTestMiniFrame() {
 void UnitTestAll() {
   UnitTestMFTransition();
   UnitTestMFWorld();
+  UnitTestMFFrontier();
+  UnitTestMFTimeManager();
   UnitTestMiniFrame();
   printf("UnitTestAll OK\n");
 }
@@ -44,7 +44,7 @@ int MFGetNbWorldsToExpand(const MiniFrame* const that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  return GSetNbElem(MFWorldsToExpand(that));
+  return MFFrontierGetNb(MFWorldsToExpand(that));
 }
 
 // Get the clock considered has start during expansion
@@ -63,6 +63,8 @@ clock_t MFGetStartExpandClock(const MiniFrame* const that) {
 }
 
 // Set the clock considered has start during expansion to 'c'
+// The time limit of the expansion is measured on the monotonic clock,
+// from now minus the time used by the process since 'c'
 #if BUILDMODE != 0
 inline
 #endif
@@ -75,12 +77,16 @@ void MFSetStartExpandClock(MiniFrame* const that, clock_t c) {
   }
 #endif
   that->_startExpandClock = c;
+  // Take care of clock() wrapping around
+  double elapsed = ((double)(clock() - c)) / MF_MILLISECTOCLOCKS;
+  if (elapsed < 0.0)
+    elapsed = 0.0;
+  MFTimeManagerStart(&(that->_timeManager), 
+    MFGetWallClockMs() - elapsed);
 }
 
 // Set the time limit for expansion of the MiniFrame 'that' to 
 // 'timeLimit', in millisecond
-// The time is measured with the function clock(), see "man clock"
-// for details
 #if BUILDMODE != 0
 inline
 #endif
@@ -93,6 +99,112 @@ void MFSetMaxTimeExpansion(MiniFrame* const that, const float timeLimit) {
   }
 #endif
   that->_maxTimeExpansion = timeLimit;
+  that->_useGameClock = false;
+}
+
+// Set the game clock of the MiniFrame 'that' to 'timeLeft' and 
+// 'increment', in millisecond, and allocate from it the time of the 
+// following expansions
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetGameClock(MiniFrame* const that, const float timeLeft,
+  const float increment) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_gameClockTimeLeft = timeLeft;
+  that->_gameClockIncrement = increment;
+  that->_useGameClock = true;
+}
+
+// Set the budget of work of the expansion of the MiniFrame 'that' to
+// 'nbExpandedWorld' worlds expanded, 'nbEvaluation' evaluations of a 
+// status by the model and 'nbPlayout' playouts of the MCTS, a budget 
+// of 0 or less doesn't limit its kind of work
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetExpansionBudget(MiniFrame* const that, 
+  const long nbExpandedWorld, const long nbEvaluation, 
+  const long nbPlayout) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_workBudget._nbExpandedWorld = nbExpandedWorld;
+  that->_workBudget._nbEvaluation = nbEvaluation;
+  that->_workBudget._nbPlayout = nbPlayout;
+}
+
+// Get the budget of work of the expansion of the MiniFrame 'that'
+#if BUILDMODE != 0
+inline
+#endif
+const MFExpansionWork* MFGetExpansionBudget(
+  const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return &(that->_workBudget);
+}
+
+// Get the work done during the last MFExpand of the MiniFrame 'that'
+#if BUILDMODE != 0
+inline
+#endif
+const MFExpansionWork* MFGetExpansionWork(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return &(that->_work);
+}
+
+// Return true if the time of the expansions of the MiniFrame 'that' 
+// is allocated from its game clock, else false
+#if BUILDMODE != 0
+inline
+#endif
+bool MFUsesGameClock(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_useGameClock;
+}
+
+// Get the time left on the game clock of the MiniFrame 'that', in 
+// millisecond
+#if BUILDMODE != 0
+inline
+#endif
+float MFGetGameClockTimeLeft(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_gameClockTimeLeft;
 }
 
 // Get the current MFWorld of the MiniFrame 'that'
@@ -125,11 +237,11 @@ const GSet* MFWorldsComputed(const MiniFrame* const that) {
   return &(that->_worldsComputed);
 }
 
-// Get the GSet of worlds to expand of the MiniFrame 'that'
+// Get the MFFrontier of worlds to expand of the MiniFrame 'that'
 #if BUILDMODE != 0
 inline
 #endif
-const GSet* MFWorldsToExpand(const MiniFrame* const that) {
+const MFFrontier* MFWorldsToExpand(const MiniFrame* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -159,6 +271,7 @@ void MFAddWorldToComputed(MiniFrame* const that, const MFWorld* const world) {
   }
 #endif
   GSetAppend((GSet*)MFWorldsComputed(that), world);  
+  MFAddWorldToHash(that, (MFWorld*)world);
 }
 
 // Return the MFModelStatus of the MFWorld 'that'
@@ -191,6 +304,38 @@ int MFWorldGetNbTrans(const MFWorld* const that) {
   return that->_nbTransition;
 }
 
+// Return true if the status of the MFWorld 'that' is an end status, 
+// else false
+#if BUILDMODE != 0
+inline
+#endif
+bool MFWorldIsEnd(const MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_isEnd;
+}
+
+// Return true if one of the transitions of the MFWorld 'that' reaches
+// a world with an end status, else false
+#if BUILDMODE != 0
+inline
+#endif
+bool MFWorldHasEndChild(const MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return (that->_nbEndChild > 0);
+}
+
 // Get the percentage of resued world of the MiniFrame 'that' during 
 // the last MFEpxand()
 #if BUILDMODE != 0
@@ -334,7 +479,13 @@ const MFWorld* MFTransitionFromWorld(const MFTransition* const that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
+#if MF_COMPACTTRANSITION
+  // The world is memorized in the slot preceding the array of 
+  // transitions it belongs to
+  return *(MFWorld* const*)(that - that->_iTrans - MF_NBTRANSHEADER);
+#else
   return that->_fromWorld;
+#endif
 }
 
 // Set the value of the MFTransition 'that' for the actor 'iActor' to 
@@ -422,11 +573,11 @@ float MFTransitionGetValue(const MFTransition* const that,
 
 
 
-// Get the set of MFTransition reaching the MFWorld 'that'
+// Get the number of MFTransition reaching the MFWorld 'that'
 #if BUILDMODE != 0
 inline
 #endif
-const GSet* MFWorldSources(const MFWorld* const that) {
+int MFWorldGetNbSource(const MFWorld* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -434,7 +585,32 @@ const GSet* MFWorldSources(const MFWorld* const that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  return &(that->_sources);
+  return that->_nbSource;
+}
+
+// Get the 'iSource'-th MFTransition reaching the MFWorld 'that'
+#if BUILDMODE != 0
+inline
+#endif
+const MFTransition* MFWorldSource(const MFWorld* const that, 
+  const int iSource) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iSource < 0 || iSource >= that->_nbSource) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iSource' is invalid (0<=%d<%d)",
+      iSource, that->_nbSource);
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (iSource < MF_NBINLINESOURCE)
+    return that->_sources[iSource];
+  else
+    return that->_extraSources[iSource - MF_NBINLINESOURCE];
 }
 
 // Return the array of values of the MFWorld 'that' for each actor
@@ -499,8 +675,7 @@ MFExpansionType MFGetExpansionType(const MiniFrame* const that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  (void)that;
-  return MF_EXPANSIONTYPE;
+  return that->_expansionType;
 }
 
 // Return true if the MFTransition is expanded, false else
@@ -551,6 +726,183 @@ float MFGetPruningDeltaVal(const MiniFrame* const that) {
   return that->_pruningDeltaVal;
 }
 
+// Set the margin above which the best transition from the current 
+// world of the MiniFrame 'that' is settled to 'margin'
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetSettledMargin(MiniFrame* const that, const float margin) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_settledMargin = margin;
+}
+
+// Get the margin above which the best transition from the current 
+// world of the MiniFrame 'that' is settled
+#if BUILDMODE != 0
+inline
+#endif
+float MFGetSettledMargin(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_settledMargin;
+}
+
+// Set the nb of expanded worlds between two updates backward of the 
+// forecast values for the MiniFrame 'that' to 'nb'
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetNbExpansionPerBackprop(MiniFrame* const that, const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_nbExpansionPerBackprop = MAX(1, nb);
+}
+
+// Get the nb of expanded worlds between two updates backward of the 
+// forecast values for the MiniFrame 'that'
+#if BUILDMODE != 0
+inline
+#endif
+int MFGetNbExpansionPerBackprop(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_nbExpansionPerBackprop;
+}
+
+// Set the nb of threads used during expansion for the MiniFrame 'that' 
+// to 'nb'
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetNbThread(MiniFrame* const that, const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_nbThread = MAX(1, nb);
+}
+
+// Get the nb of threads used during expansion for the MiniFrame 'that'
+#if BUILDMODE != 0
+inline
+#endif
+int MFGetNbThread(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_nbThread;
+}
+
+// Set the flag controling if the threads of the MCTS expansion share 
+// one tree for the MiniFrame 'that' to 'flag'
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetTreeParallel(MiniFrame* const that, const bool flag) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_treeParallel = flag;
+}
+
+// Return the flag controling if the threads of the MCTS expansion 
+// share one tree for the MiniFrame 'that'
+#if BUILDMODE != 0
+inline
+#endif
+bool MFIsTreeParallel(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_treeParallel;
+}
+
+// Set the nb of best lines from the current world the expansion of
+// the MiniFrame 'that' keeps resolved to 'nb'
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+inline
+#endif
+void MFSetNbMultiPV(MiniFrame* const that, const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_nbMultiPV = MAX(1, nb);
+}
+
+// Get the nb of best lines from the current world the expansion of 
+// the MiniFrame 'that' keeps resolved
+#if BUILDMODE != 0
+inline
+#endif
+int MFGetNbMultiPV(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_nbMultiPV;
+}
+
+// Return true if the MiniFrame 'that' is pondering, else false
+#if BUILDMODE != 0
+inline
+#endif
+bool MFIsPondering(const MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_isPondering;
+}
+
 // Get the nb of worlds not found during MFSetCurWorld
 #if BUILDMODE != 0
 inline
@@ -581,4 +933,72 @@ int MFGetMaxDepthExpReached(const MiniFrame* const that) {
   return that->_maxDepthExpReached;
 }
 
+// Get the nb of worlds in the MFFrontier 'that'
+#if BUILDMODE != 0
+inline
+#endif
+int MFFrontierGetNb(const MFFrontier* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_nbWorld;
+}
+
+// Get the 'iWorld'-th world in the MFFrontier 'that'
+// The worlds are not ordered by their order of expansion
+#if BUILDMODE != 0
+inline
+#endif
+MFWorld* MFFrontierGet(const MFFrontier* const that, const int iWorld) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iWorld < 0 || iWorld >= MFFrontierGetNb(that)) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iWorld' is invalid (0<=%d<%d)",
+      iWorld, MFFrontierGetNb(that));
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (that->_isSorted)
+    return that->_elems[iWorld]._world;
+  else
+    return that->_worlds[(that->_head + iWorld) & (that->_nbAlloc - 1)];
+}
+
+// Get the world of the MFFrontier 'that' which is popped after 'iNext'
+// other worlds if no world is pushed in the meantime
+// If the frontier is sorted, only the next world (iNext equals 0) is 
+// exact, the following ones are the ones near the top of the heap
+#if BUILDMODE != 0
+inline
+#endif
+MFWorld* MFFrontierPeek(const MFFrontier* const that, const int iNext) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iNext < 0 || iNext >= MFFrontierGetNb(that)) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iNext' is invalid (0<=%d<%d)",
+      iNext, MFFrontierGetNb(that));
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // The sorted frontier pops the top of the heap, the unsorted one 
+  // pops the last world of the ring buffer
+  if (that->_isSorted)
+    return that->_elems[iNext]._world;
+  else
+    return MFFrontierGet(that, that->_nbWorld - 1 - iNext);
+}
 
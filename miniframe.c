@@ -16,10 +16,16 @@ bool MFWorldIsPrunedDuringExpansion(const MFWorld* const that,
   const MiniFrame* const mf, const MFTransition* const trans);
 
 // Search in computed worlds of the MiniFrame 'that' if there is 
-// one with same status as the MFModelStatus 'status'
+// one, other than 'excluded', with same status as the MFModelStatus 
+// 'status'
+// 'excluded' can be null
 // If there is one return it, if not return null
 MFWorld* MFSearchWorld(const MiniFrame* const that, 
-  const MFModelStatus* const status);
+  const MFModelStatus* const status, const MFWorld* const excluded);
+
+// Resize the hash table of worlds of the MiniFrame 'that' to 
+// 'nbBucket' buckets, 'nbBucket' must be a power of 2
+void MFResizeWorldHash(MiniFrame* const that, const int nbBucket);
 
 // Set the MFWorld 'toWorld' has the result of the 'iTrans' transition
 // of the world 'that'
@@ -29,36 +35,307 @@ void MFWorldSetTransitionToWorld(
 
 // Update backward the forecast values for each 
 // transitions leading to the MFWorld 'world' in the MiniFrame 'that'
-// Use a penalty growing with each recursive call to 
-// MFUpdateForecastValues to give priority to fastest convergence to 
-// best solution
-// Avoid infinite loop due to reuse of computed worlds by putting 
-// visited world in the set 'updatedWorld'
+// Use a penalty growing with the distance to 'world' to give priority
+// to fastest convergence to best solution
+// The worlds on the stack are stamped with the epoch of the update, 
+// which avoids infinite loop due to reuse of computed worlds, and 
+// restamped with the next epoch when popped, so that another path 
+// reaching them later during the update can update them again
 void MFUpdateForecastValues(MiniFrame* const that, 
-  const MFWorld* const world, int delayPenalty, 
-  GSet* const updatedWorld);
+  const MFWorld* const world);
+
+// Propagate backward the forecast values of the MFWorld 'world' in the
+// MiniFrame 'that' as MFUpdateForecastValues, with the penalty 
+// starting at 'delayPenalty', during the current epoch of update
+void MFPropagateForecastValues(MiniFrame* const that, 
+  const MFWorld* const world, const int delayPenalty);
+
+// Double the size of the stack used by MFUpdateForecastValues in the
+// MiniFrame 'that'
+void MFGrowBackpropStack(MiniFrame* const that);
+
+// Mark the MFWorld 'world' of the MiniFrame 'that' as having forecast
+// values to be updated backward by the next call to 
+// MFUpdateDirtyForecastValues
+void MFMarkWorldDirty(MiniFrame* const that, MFWorld* const world);
+
+// Pop the deepest world among the worlds marked by MFMarkWorldDirty 
+// in the MiniFrame 'that'
+// The depth of a reused world is the one at its creation, it may be 
+// stale and the order then differs from the distance to the expanded
+// worlds, MFUpdateDirtyForecastValues covers it by propagating again
+// the worlds already updated
+// Return the world
+MFWorld* MFPopDirtyWorld(MiniFrame* const that);
+
+// Update backward the forecast values for each transitions leading 
+// to the worlds marked by MFMarkWorldDirty in the MiniFrame 'that'
+// The worlds are updated in reverse order of depth, with a penalty 
+// growing with the distance to the deepest marked world
+// A world already updated whose forecast values change again, as the
+// reused worlds may be deeper than the worlds reaching them, is 
+// propagated backward by MFPropagateForecastValues
+void MFUpdateDirtyForecastValues(MiniFrame* const that);
 
 // Update the values of the MFTransition 'that' with 'val'
 // Return true if the value has been updated, else false
 bool MFTransitionUpdateValues(MFTransition* const that, const float* val);
 
+// Return true if the MFWorld 'world' is in the principal variation 
+// of the MiniFrame 'that', else false
+bool MFWorldIsOnPV(const MiniFrame* const that, 
+  const MFWorld* const world);
+
+// Invalidate the principal variation of the MiniFrame 'that' if the 
+// MFWorld 'world' is in it and its best transition doesn't match 
+// anymore the principal variation
+void MFCheckPV(MiniFrame* const that, const MFWorld* const world);
+
+// Get the transition following the MFWorld 'that' in its best story 
+// for the actor 'iActor'
+// Return NULL if the world is an end world or has no best transition
+const MFTransition* MFWorldBestStoryTrans(const MFWorld* const that, 
+  const int iActor);
+
+// Make sure the MiniFrame 'that' has at least 'nb' pools for the 
+// worker threads
+void MFAllocThreadPools(MiniFrame* const that, const int nb);
+
+// Expand the MiniFrame 'mf' until it's requested to stop
+// Used as the function of the pondering thread
+void* MFPonder(void* mf);
+
+// Allocate the time of the next expansion of the MiniFrame 'that' 
+// from its game clock
+void MFAllocateTimeFromGameClock(MiniFrame* const that);
+
+// Expand the MiniFrame 'that' by one of the expansions memorizing the
+// graph of worlds in its frontier: by value, by width or by depth
+void MFExpandGraph(MiniFrame* const that);
+
+// Expand the MiniFrame 'that' by Monte Carlo tree search
+void MFExpandMCTS(MiniFrame* const that);
+
+// Expand the MiniFrame 'that' by alpha-beta search from its current
+// world
+void MFExpandAlphaBeta(MiniFrame* const that);
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandGraph() to the world with status 'status'
+void MFSetCurWorldGraph(MiniFrame* const that,
+  const MFModelStatus* const status);
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandMCTS() to the world with status 'status'
+void MFSetCurWorldMCTS(MiniFrame* const that,
+  const MFModelStatus* const status);
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandAlphaBeta() to the world with status 'status'
+void MFSetCurWorldAlphaBeta(MiniFrame* const that,
+  const MFModelStatus* const status);
+
+// Free all the worlds of the MiniFrame 'that', including its current
+// world
+void MFFreeWorlds(MiniFrame* const that);
+
+// Create a new MFParallelExpansion for the MiniFrame 'mf' and start its
+// worker threads
+// Return the new MFParallelExpansion
+MFParallelExpansion* MFParallelExpansionCreate(MiniFrame* const mf);
+
+// Stop the worker threads and free the memory used by the 
+// MFParallelExpansion 'that', including the worlds created in advance
+// and not used
+void MFParallelExpansionFree(MFParallelExpansion** that);
+
+// Make sure the worlds reached from the next world of the frontier of
+// the MiniFrame 'mf' have been created by the MFParallelExpansion 
+// 'that', if not create in parallel the ones of the next worlds of the 
+// frontier whose depth is not over 'limitDepth'
+// The worlds created in advance are counted as evaluated by 'mf' even
+// if they are not used later
+void MFParallelExpansionPrefetch(MFParallelExpansion* const that,
+  MiniFrame* const mf, const int limitDepth);
+
+// Deal the jobs of the MFParallelExpansion 'that' to its threads and
+// run them in one round
+void MFParallelExpansionRun(MFParallelExpansion* const that);
+
+// Get the worlds created in advance by the MFParallelExpansion 'that' 
+// from the MFWorld 'world'
+// Return null if there are none
+MFPrefetchedWorld* MFParallelExpansionGet(
+  MFParallelExpansion* const that, const MFWorld* const world);
+
+// Free the worlds and statuses of the MFPrefetchedWorld 'that' which 
+// have not been used and free its slot
+void MFPrefetchedWorldRelease(MFPrefetchedWorld* const that);
+
+// Run the jobs of the current round from the deque of the 
+// MFExpansionThread 'that', then the ones stolen from the other threads
+void MFExpansionThreadRun(MFExpansionThread* const that);
+
+// Loop on the rounds of the parallel expansion until it's over
+// Used as the function of the worker threads
+void* MFExpansionThreadMain(void* thread);
+
+// Pop the job at the bottom of the deque of the MFExpansionThread 'that'
+// Return its index, or -1 if the deque is empty
+int MFExpansionThreadPop(MFExpansionThread* const that);
+
+// Steal the job at the top of the deque of the MFExpansionThread 'that'
+// Return its index, or -1 if the deque is empty
+int MFExpansionThreadSteal(MFExpansionThread* const that);
+
+// Create a new static MFMCTSTree for the MiniFrame 'mf' with the 
+// MFWorld 'root' allocated from the MFWorldPool 'pool' and memorized
+// in the GSet 'worlds'
+// If 'pool' is null the tree uses its own pool and set, and its root 
+// is a new world with the same status as 'root'
+// If only 'worlds' is null the tree memorizes the worlds it adds to 
+// 'root' in its own set
+// The tree is searched with a copy of the time manager of 'mf'
+// Return the new MFMCTSTree
+MFMCTSTree MFMCTSTreeCreateStatic(const MiniFrame* const mf,
+  MFWorld* const root, MFWorldPool* const pool, GSet* const worlds);
+
+// Free the memory used by the worlds remaining in the own set of the
+// MFMCTSTree 'that' and its own pool
+void MFMCTSTreeFreeStatic(MFMCTSTree* const that);
+
+// Return a random number in [0.0, 1.0] from the random generator of 
+// the MFMCTSTree 'that'
+float MFMCTSTreeRnd(MFMCTSTree* const that);
+
+// Play out randomly from the MFWorld 'leafWorld' of the MFMCTSTree
+// 'that' until an end status or the max depth of expansion, and 
+// memorize the values of the reached status in 'values' (set to 0.0 
+// by the caller)
+// The playout steps bare MFModelStatus, generates their transitions 
+// only when one more step is needed and evaluates only the reached one
+void MFMCTSTreePlayout(MFMCTSTree* const that, 
+  const MFWorld* const leafWorld, float* const values);
+
+// Run one iteration of the MCTS on the MFMCTSTree 'that': selection, 
+// expansion, playout and backup
+void MFMCTSTreeIterate(MFMCTSTree* const that);
+
+// Iterate the MCTS on the MFMCTSTree 'tree' until its deadline
+// Used as the function of the worker threads
+void* MFMCTSTreeSearch(void* tree);
+
+// Update the stability of the search of the MFMCTSTree 'that' with 
+// the most visited transition from its root
+// Return true if this transition is settled, else false
+bool MFMCTSTreeCheckStability(MFMCTSTree* const that);
+
+// Set the budget of work of the MFMCTSTree 'that' to its share of the
+// budget of its MiniFrame, as the 'iTree'-th of 'nbTree' trees 
+// searched at the same time
+void MFMCTSTreeShareBudget(MFMCTSTree* const that, const int nbTree,
+  const int iTree);
+
+// Select the transition to play out from the MFWorld 'root' of the
+// MCTS, given the transition 'iSelTrans' selected by upper confidence
+// bound for the actor 'sente'
+// If 'iSelTrans' is one of the 'nbPV' best transitions by average 
+// value, the least visited of them is selected instead
+// Return the index of the selected transition
+int MFMCTSSelectMultiPV(const MFWorld* const root, const int sente,
+  const int iSelTrans, const int nbPV);
+
+// Add atomically 'val' to the float 'that'
+void MFAtomicAddFloat(_Atomic float* const that, const float val);
+
+// Create the statistics of the MCTS for the transitions of the MFWorld
+// 'that' when it's added to the tree of the MCTS
+// Do nothing if they already exist
+void MFWorldCreateMCTSStats(MFWorld* const that);
+
+// Update the values, nb of end children and best transitions of all 
+// the worlds of the tree of the MiniFrame 'that' from the statistics 
+// of their transitions, after a search shared by several threads
+void MFMCTSUpdateTreeValues(MiniFrame* const that);
+
+// Search by alpha-beta pruning the value of the MFModelStatus 'status'
+// from the pov of the searched actor of the MiniFrame 'that', up to 
+// 'depth' transitions and inside the window ['alpha', 'beta']
+// The sente maximises the value if it is the searched actor, else it
+// minimises it
+// The values of all the actors at the leaf of the principal variation
+// of the search are memorized in 'leafValues'
+// The transitions of a status are searched first from the best one of
+// its last search, memorized in the table of best transitions
+// If the time limit is reached the search is aborted and the returned
+// value is meaningless
+float MFSearchAlphaBeta(MiniFrame* const that, 
+  const MFModelStatus* const status, const int depth, float alpha, 
+  float beta, float* const leafValues);
+
+// Return true if the 'iElem'-th element of the MFFrontier 'that' 
+// must be expanded before its 'jElem'-th element, else false
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFFrontierIsBefore(const MFFrontier* const that, const int iElem,
+  const int jElem);
+
+// Swap the 'iElem'-th and 'jElem'-th elements of the MFFrontier 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+void MFFrontierSwap(MFFrontier* const that, const int iElem,
+  const int jElem);
+
+// Move up the 'iElem'-th element of the MFFrontier 'that' until the 
+// heap property is restored
+void MFFrontierSiftUp(MFFrontier* const that, int iElem);
+
+// Move down the 'iElem'-th element of the MFFrontier 'that' until the 
+// heap property is restored
+void MFFrontierSiftDown(MFFrontier* const that, int iElem);
+
+// Double the size of the ring buffer of the MFFrontier 'that', the 
+// worlds are moved at the beginning of the new array
+void MFFrontierGrow(MFFrontier* const that);
+
 // Pop a MFTransition from the sources of the MFWorld 'that'
 #if BUILDMODE != 0
 static inline
 #endif
 MFTransition* MFWorldPopSource(MFWorld* const that);
 
-// Remove the MFTransition 'source' from the sources of the 
-// MFWorld 'that'
-void MFWorldRemoveSource(MFWorld* const that, 
-  const MFTransition* const source);
-
 // Get the best MFModelTransition for the 'iActor'-th actor in the 
 // MFWorld 'that'
 // Return NULL if the world has no transition
 const MFModelTransition* MFWorldBestTransition(
   const MFWorld* const that, const int iActor);
 
+// Free memory used by the properties of the MFWorld 'that', without
+// updating the worlds linked to it
+void MFWorldFreeProperties(MFWorld* const that);
+
+// Update the end status flag of the MFWorld 'that' after its status 
+// has been modified, and the flags of the worlds reaching it
+void MFWorldUpdateIsEnd(MFWorld* const that);
+
+// Search the index of the best transition for the 'iActor'-th actor 
+// among the transitions of the MFWorld 'that'
+// Return -1 if the world has no transition
+int MFWorldSearchBestTransition(const MFWorld* const that, 
+  const int iActor);
+
+// Reset the cached best transitions of the MFWorld 'that' for all 
+// the actors
+void MFWorldResetBestTransition(MFWorld* const that);
+
+// Update the cached best transitions of the MFWorld 'that' after the
+// values or the result of its 'iTrans'-th transition have changed
+// 'prevValues' are the values of the transition before the change
+void MFWorldUpdateBestTransition(MFWorld* const that, const int iTrans,
+  const float* const prevValues);
+
 // ================ Functions implementation ====================
 
 // Create a new MiniFrame the initial world 'initStatus'
@@ -76,23 +353,70 @@ MiniFrame* MiniFrameCreate(const MFModelStatus* const initStatus) {
   MiniFrame *that = PBErrMalloc(MiniFrameErr, sizeof(MiniFrame));
   // Set properties
   that->_nbStep = 0;
+  that->_expansionType = (MFExpansionType)MF_EXPANSIONTYPE;
   MFSetMaxTimeExpansion(that, MF_DEFAULTTIMEEXPANSION);
-  that->_curWorld = MFWorldCreate(initStatus);
+  that->_worldPool = MFWorldPoolCreateStatic();
+  that->_threadPools = NULL;
+  that->_nbThreadPool = 0;
+  that->_curWorld = 
+    MFWorldCreateFromPool(&(that->_worldPool), initStatus);
   that->_worldsComputed = GSetCreateStatic();
-  that->_worldsToExpand = GSetCreateStatic();
-  MFAddWorldToExpand(that, MFCurWorld(that));
+  that->_worldsToExpand = MFFrontierCreateStatic(
+    that->_expansionType == MFExpansionTypeValue);
+  that->_backpropStack = NULL;
+  that->_nbAllocBackprop = 0;
+  that->_backpropEpoch = 1;
+  that->_nbExpansionPerBackprop = MF_DEFAULTNBEXPANSIONPERBACKPROP;
+  that->_dirtyWorlds = NULL;
+  that->_nbDirtyWorld = 0;
+  that->_nbAllocDirty = 0;
+  that->_pv = NULL;
+  that->_pvWorlds = NULL;
+  that->_pvLength = 0;
+  that->_nbAllocPV = 0;
+  that->_pvActor = 0;
+  that->_isPVValid = false;
+  that->_nbBucketWorldsHash = MF_NBWORLDHASHBUCKET;
+  that->_nbWorldsHash = 0;
+  that->_rehashCostPerWorld = MF_REHASHCOSTPERWORLD;
+  that->_worldsHash = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFWorld*) * that->_nbBucketWorldsHash);
+  for (int iBucket = that->_nbBucketWorldsHash; iBucket--;)
+    that->_worldsHash[iBucket] = NULL;
+  // The tree of the MCTS is memorized in the computed worlds
+  if (that->_expansionType == MFExpansionTypeMCTS)
+    GSetAppend(&(that->_worldsComputed), that->_curWorld);
+  else
+    MFAddWorldToExpand(that, MFCurWorld(that));
   that->_timeUnusedExpansion = 0.0;
   that->_reuseWorld = false;
   that->_percWorldReused = 0.0;
   that->_startExpandClock = 0;
+  that->_timeManager = MFTimeManagerCreateStatic();
+  that->_useGameClock = false;
+  that->_gameClockTimeLeft = 0.0;
+  that->_gameClockIncrement = 0.0;
+  that->_avgNbTrans = 0.0;
+  that->_workBudget = MFExpansionWorkCreateStatic();
+  that->_work = MFExpansionWorkCreateStatic();
   that->_maxDepthExp = MF_DEFAULTMAXDEPTHEXP;
   that->_pruningDeltaVal = MF_PRUNINGDELTAVAL;
+  that->_settledMargin = MF_DEFAULTSETTLEDMARGIN;
   that->_maxDepthExpReached = 0;
   that->_nbWorldNotFound = 0;
   that->_nbTryMTCS = 0;
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK
+  that->_nbThread = MF_DEFAULTNBTHREAD;
+  that->_treeParallel = false;
+  that->_nbMultiPV = MF_DEFAULTNBMULTIPV;
+  that->_isPondering = false;
+  atomic_init(&(that->_stopExpand), false);
   that->_expByDepthAppendPos = 0;
-#endif
+  that->_keepEpoch = 1;
+  that->_searchActor = 0;
+  that->_nbSearch = 0;
+  that->_isSearchAborted = false;
+  that->_isSearchCut = false;
+  that->_alphaBetaTable = NULL;
   // Return the new MiniFrame
   return that;
 }
@@ -100,6 +424,23 @@ MiniFrame* MiniFrameCreate(const MFModelStatus* const initStatus) {
 // Create a new MFWorld with a copy of the MFModelStatus 'status'
 // Return the new MFWorld
 MFWorld* MFWorldCreate(const MFModelStatus* const status) {
+#if BUILDMODE == 0
+  if (status == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'status' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Return the new MFWorld allocated with malloc
+  return MFWorldCreateFromPool(NULL, status);
+}
+
+// Create a new MFWorld with a copy of the MFModelStatus 'status', 
+// allocated from the MFWorldPool 'pool'
+// If 'pool' is null the MFWorld is allocated with malloc
+// Return the new MFWorld
+MFWorld* MFWorldCreateFromPool(MFWorldPool* const pool, 
+  const MFModelStatus* const status) {
 #if BUILDMODE == 0
   if (status == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -108,19 +449,55 @@ MFWorld* MFWorldCreate(const MFModelStatus* const status) {
   }
 #endif
   // Allocate memory
-  MFWorld *that = PBErrMalloc(MiniFrameErr, sizeof(MFWorld));
-  // Set the status
+  MFWorld *that = NULL;
+  if (pool != NULL)
+    that = MFWorldPoolAlloc(pool);
+  else
+    that = PBErrMalloc(MiniFrameErr, sizeof(MFWorld));
+  that->_pool = pool;
+  that->_mctsStats = NULL;
   // Set the status
   MFModelStatusCopy(status, &(that->_status));
-  // Initialise the set of transitions reaching this world
-  that->_sources = GSetCreateStatic();
-  // Set the possible transitions from this world 
+  // Initialise the transitions reaching this world
+  that->_nbSource = 0;
+  that->_extraSources = NULL;
+  that->_nbExtraSourceAlloc = 0;
+  // Initialise the properties used by the hash table of worlds
+  that->_hash = 0;
+  that->_nextWorldHash = NULL;
+  that->_isHashed = false;
+  // Initialise the flags about end status
+  that->_isEnd = MFModelStatusIsEnd(status);
+  that->_nbEndChild = 0;
+  that->_visitEpoch = 0;
+  that->_keepEpoch = 0;
+  that->_iPV = -1;
+  // Set the possible transitions from this world, in an array sized 
+  // to their number
   MFModelTransition transitions[MF_NBMAXTRANSITION];
   MFModelStatusGetTrans(status, transitions, &(that->_nbTransition));
+  if (that->_nbTransition == 0)
+    that->_transitions = NULL;
+  else if (pool != NULL)
+    that->_transitions = MFWorldPoolAllocTrans(pool, 
+      that->_nbTransition + MF_NBTRANSHEADER) + MF_NBTRANSHEADER;
+  else
+    that->_transitions = (MFTransition*)PBErrMalloc(MiniFrameErr, 
+      sizeof(MFTransition) * (that->_nbTransition + MF_NBTRANSHEADER)) +
+      MF_NBTRANSHEADER;
   MFTransition* thatTransitions = that->_transitions;
-  for (int iTrans = that->_nbTransition; iTrans--;)
+  for (int iTrans = that->_nbTransition; iTrans--;) {
     thatTransitions[iTrans] = 
       MFTransitionCreateStatic(that, transitions + iTrans);
+#if MF_COMPACTTRANSITION
+    thatTransitions[iTrans]._iTrans = iTrans;
+#endif
+  }
+#if MF_COMPACTTRANSITION
+  // Memorize the world in the slot preceding its transitions
+  if (thatTransitions != NULL)
+    *(MFWorld**)(thatTransitions - MF_NBTRANSHEADER) = that;
+#endif
 #if MF_LIMITDEPTH == true
   // Init the depth
   that->_depth = 0;
@@ -131,6 +508,8 @@ MFWorld* MFWorldCreate(const MFModelStatus* const status) {
     values[iActor] = 0.0;
   MFModelStatusGetValues(status, values);
   MFWorldSetValues(that, values);
+  // Init the best transitions
+  MFWorldResetBestTransition(that);
   // Return the new MFWorld
   return that;
 }
@@ -149,15 +528,46 @@ MFWorld MFWorldCreateStatic(const MFModelStatus* const status) {
   MFWorld that;
   // Set the status
   MFModelStatusCopy(status, &(that._status));
-  // Initialise the set of transitions reaching this world
-  that._sources = GSetCreateStatic();
-  // Set the possible transitions from this world 
+  // Initialise the transitions reaching this world
+  that._nbSource = 0;
+  that._extraSources = NULL;
+  that._nbExtraSourceAlloc = 0;
+  // Initialise the properties used by the hash table of worlds
+  that._hash = 0;
+  that._nextWorldHash = NULL;
+  that._isHashed = false;
+  that._pool = NULL;
+  that._mctsStats = NULL;
+  // Initialise the flags about end status
+  that._isEnd = MFModelStatusIsEnd(status);
+  that._nbEndChild = 0;
+  that._visitEpoch = 0;
+  that._keepEpoch = 0;
+  that._iPV = -1;
+  // Set the possible transitions from this world, in an array sized 
+  // to their number
   MFModelTransition transitions[MF_NBMAXTRANSITION];
   MFModelStatusGetTrans(status, transitions, &(that._nbTransition));
+  if (that._nbTransition == 0)
+    that._transitions = NULL;
+  else
+    that._transitions = (MFTransition*)PBErrMalloc(MiniFrameErr, 
+      sizeof(MFTransition) * (that._nbTransition + MF_NBTRANSHEADER)) +
+      MF_NBTRANSHEADER;
   MFTransition* thatTransitions = that._transitions;
-  for (int iTrans = that._nbTransition; iTrans--;)
+  for (int iTrans = that._nbTransition; iTrans--;) {
     thatTransitions[iTrans] = 
       MFTransitionCreateStatic(NULL, transitions + iTrans);
+#if MF_COMPACTTRANSITION
+    thatTransitions[iTrans]._iTrans = iTrans;
+#endif
+  }
+#if MF_COMPACTTRANSITION
+  // The static world is returned by copy, so its address can't be 
+  // memorized, its transitions have no origin as in the normal mode
+  if (thatTransitions != NULL)
+    *(MFWorld**)(thatTransitions - MF_NBTRANSHEADER) = NULL;
+#endif
 #if MF_LIMITDEPTH == true
   // Init the depth
   that._depth = 0;
@@ -165,29 +575,30 @@ MFWorld MFWorldCreateStatic(const MFModelStatus* const status) {
   // Set the values
   float values[MF_NBMAXACTOR] = {0.0};
   MFWorldSetValues(&that, values);
+  // Init the best transitions
+  MFWorldResetBestTransition(&that);
   // Return the new MFWorld
   return that;
 }
 
 // Create a new static MFTransition for the MFWorld 'world' with the
 // MFModelTransition 'transition'
+// 'world' is null for the transitions of a static world
 // Return the new MFTransition
 MFTransition MFTransitionCreateStatic(const MFWorld* const world,
   const MFModelTransition* const transition) {
-#if BUILDMODE == 0
-#if MF_EXPANSIONTYPE != MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
-  if (world == NULL) {
-    MiniFrameErr->_type = PBErrTypeNullPointer;
-    sprintf(MiniFrameErr->_msg, "'world' is null");
-    PBErrCatch(MiniFrameErr);
-  }
-#endif
-#endif
   // Declare a variable to memorize the new action
   MFTransition that;
   // Set properties
   that._transition = *transition;
+#if MF_COMPACTTRANSITION
+  // The world is memorized by the array of transitions it belongs to,
+  // the index is set by the world
+  (void)world;
+  that._iTrans = 0;
+#else
   that._fromWorld = (MFWorld*)world;
+#endif
   that._toWorld = NULL;
   float* thatValues = that._values;
   for (int iActor = MF_NBMAXACTOR; iActor--;)
@@ -200,32 +611,78 @@ MFTransition MFTransitionCreateStatic(const MFWorld* const world,
 void MiniFrameFree(MiniFrame** that) {
   // Check argument
   if (that == NULL || *that == NULL) return;
+  // Make sure the MiniFrame is not used by the pondering anymore
+  MFStopPondering(*that);
   // Free memory
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
-  MFWorldFree(&((*that)->_curWorld));
-#else
-  (*that)->_curWorld = NULL;
-#endif
-  while(MFGetNbComputedWorlds(*that) > 0) {
-    MFWorld* world = GSetPop((GSet*)MFWorldsComputed(*that));
-    MFWorldFree(&world);
-  }
-  while(MFGetNbWorldsToExpand(*that) > 0) {
-    MFWorld* world = GSetPop((GSet*)MFWorldsToExpand(*that));
-    MFWorldFree(&world);
+  MFFreeWorlds(*that);
+  MFFrontierFreeStatic(&((*that)->_worldsToExpand));
+  free((*that)->_backpropStack);
+  free((*that)->_dirtyWorlds);
+  free((*that)->_pv);
+  free((*that)->_pvWorlds);
+  MFWorldPoolFreeStatic(&((*that)->_worldPool));
+  for (int iPool = (*that)->_nbThreadPool; iPool--;) {
+    MFWorldPoolFreeStatic((*that)->_threadPools[iPool]);
+    free((*that)->_threadPools[iPool]);
   }
+  free((*that)->_threadPools);
+  free((*that)->_worldsHash);
+  free((*that)->_alphaBetaTable);
   free(*that);
   *that = NULL;
 }
 
+// Free all the worlds of the MiniFrame 'that', including its current
+// world
+void MFFreeWorlds(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // All the worlds are freed at once, so there is no need to update
+  // the links between worlds, only the properties of the worlds are
+  // freed before releasing them to their pool
+  // The current world of the alpha-beta expansion is the only one not
+  // memorized in the computed worlds or the frontier
+  if (that->_expansionType == MFExpansionTypeAlphaBeta)
+    MFWorldFree(&(that->_curWorld));
+  else
+    that->_curWorld = NULL;
+  while (MFGetNbComputedWorlds(that) > 0 || 
+    MFGetNbWorldsToExpand(that) > 0) {
+    MFWorld* world = (MFGetNbComputedWorlds(that) > 0 ?
+      GSetPop((GSet*)MFWorldsComputed(that)) :
+      MFFrontierPop(&(that->_worldsToExpand)));
+    MFWorldFreeProperties(world);
+    if (world->_pool != NULL)
+      MFWorldPoolRelease(world->_pool, world);
+    else
+      free(world);
+  }
+  for (int iBucket = that->_nbBucketWorldsHash; iBucket--;)
+    that->_worldsHash[iBucket] = NULL;
+  that->_nbWorldsHash = 0;
+  that->_nbDirtyWorld = 0;
+}
+
 // Free memory used by the MFWorld 'that'
 void MFWorldFree(MFWorld** that) {
   // Check argument
   if (that == NULL || *that == NULL) return;
   // Remove from sources and childs
-  while (GSetNbElem(MFWorldSources(*that)) > 0) {
+  while (MFWorldGetNbSource(*that) > 0) {
     MFTransition* transSource = MFWorldPopSource(*that);
     MFTransitionSetToWorld(transSource, NULL);
+    MFWorld* fromWorld = (MFWorld*)MFTransitionFromWorld(transSource);
+    if (fromWorld != NULL) {
+      MFWorldUpdateBestTransition(fromWorld, 
+        transSource - fromWorld->_transitions, transSource->_values);
+      if (MFWorldIsEnd(*that))
+        --(fromWorld->_nbEndChild);
+    }
   }
   for (int iTrans = MFWorldGetNbTrans(*that); iTrans--;) {
     const MFTransition* trans = MFWorldTransition(*that, iTrans);
@@ -234,29 +691,94 @@ void MFWorldFree(MFWorld** that) {
       MFWorldRemoveSource(toWorld, trans);
   }
   // Free memory
-  GSetFlush(&((*that)->_sources));
-  MFModelStatusFreeStatic(&((*that)->_status));
-  MFTransition* thatTransitions = (*that)->_transitions;
-  for (int iAct = (*that)->_nbTransition; iAct--;) {
+  MFWorldFreeProperties(*that);
+  if ((*that)->_pool != NULL)
+    MFWorldPoolRelease((*that)->_pool, *that);
+  else
+    free(*that);
+  *that = NULL;
+}
+
+// Free memory used by the properties of the MFWorld 'that', without
+// updating the worlds linked to it
+void MFWorldFreeProperties(MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  free(that->_extraSources);
+  that->_extraSources = NULL;
+  that->_nbExtraSourceAlloc = 0;
+  that->_nbSource = 0;
+  MFModelStatusFreeStatic(&(that->_status));
+  free(that->_mctsStats);
+  that->_mctsStats = NULL;
+  MFTransition* thatTransitions = that->_transitions;
+  for (int iAct = that->_nbTransition; iAct--;) {
     if (thatTransitions[iAct]._toWorld != NULL)
       MFTransitionFreeStatic(thatTransitions + iAct);
   }
-  free(*that);
-  *that = NULL;
+  if (thatTransitions != NULL) {
+    if (that->_pool != NULL)
+      MFWorldPoolReleaseTrans(that->_pool, 
+        thatTransitions - MF_NBTRANSHEADER, 
+        that->_nbTransition + MF_NBTRANSHEADER);
+    else
+      free(thatTransitions - MF_NBTRANSHEADER);
+  }
+  that->_transitions = NULL;
+  that->_nbTransition = 0;
 }
 
-// Free memory used by properties of the MFTransition 'that'
-void MFTransitionFreeStatic(MFTransition* that) {
+// Create a new static MFWorldPool
+// Return the new MFWorldPool
+MFWorldPool MFWorldPoolCreateStatic(void) {
+  // Declare the new pool
+  MFWorldPool that;
+  // Set properties
+  that._blocks = NULL;
+  that._nbUsedInBlock = 0;
+  that._freeWorlds = NULL;
+  that._transBlocks = NULL;
+  that._nbUsedInTransBlock = 0;
+  for (int iSize = MF_NBMAXTRANSITION + MF_NBTRANSHEADER + 1; iSize--;)
+    that._freeTransitions[iSize] = NULL;
+  // Return the new pool
+  return that;
+}
+
+// Free the memory used by the properties of the MFWorldPool 'that'
+// All the MFWorld and arrays of MFTransition allocated from the pool 
+// are freed at once, the memory used by the properties of the MFWorld
+// must have been freed before
+void MFWorldPoolFreeStatic(MFWorldPool* const that) {
   // Check argument
   if (that == NULL) return;
-  // Free memory
-  MFModelTransitionFreeStatic(&(that->_transition));
+  // Free the blocks
+  while (that->_blocks != NULL) {
+    MFWorldPoolBlock* block = that->_blocks;
+    that->_blocks = block->_next;
+    free(block);
+  }
+  that->_nbUsedInBlock = 0;
+  that->_freeWorlds = NULL;
+  while (that->_transBlocks != NULL) {
+    MFTransitionPoolBlock* block = that->_transBlocks;
+    that->_transBlocks = block->_next;
+    free(block);
+  }
+  that->_nbUsedInTransBlock = 0;
+  for (int iSize = MF_NBMAXTRANSITION + MF_NBTRANSHEADER + 1; iSize--;)
+    that->_freeTransitions[iSize] = NULL;
 }
 
-// Expand the MiniFrame 'that' until it reaches its time limit or can't 
-// expand anymore
-#if MF_EXPANSIONTYPE != MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
-void MFExpand(MiniFrame* that) {
+// Get the memory for one MFWorld from the MFWorldPool 'that'
+// Released worlds are reused first
+// Return the uninitialised MFWorld
+MFWorld* MFWorldPoolAlloc(MFWorldPool* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -264,96 +786,1110 @@ void MFExpand(MiniFrame* that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  // Declare a variable to memorize the time at beginning of the whole 
-  // expansion process
-  clock_t clockStart = MFGetStartExpandClock(that);
-  // Declare a variable to memorize the maximum time used for one 
-  // step of expansion
-  double maxTimeOneStep = 0.0;
-#if MF_USETELEMETRY
-  that->_maxDepthExpReached = that->_curWorld->_depth;
-  // Declare a variable to memorize the number of reused worlds
-  int nbReusedWorld = 0;
-  // Declare a variable to memorize the number of worlds searched for 
-  // reuse
-  int nbWorldSearchForReuse = 0;
-#endif
-  // Declare a variable to memorize the time spent expanding
-  double timeUsed = 
-    ((double)(clock() - clockStart)) / MF_MILLISECTOCLOCKS;
-  // Ensure the set of world to expand is not empty
-  if (GSetNbElem(MFWorldsToExpand(that)) == 0) {
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK
-    that->_expByDepthAppendPos = 0;
-#endif
-    MFAddWorldToExpand(that, MFCurWorld(that));
-    GSetRemoveFirst((GSet*)MFWorldsComputed(that), MFCurWorld(that));
+  // Declare a variable to memorize the returned world
+  MFWorld* world = NULL;
+  // If there is a released world, reuse it
+  if (that->_freeWorlds != NULL) {
+    world = that->_freeWorlds;
+    that->_freeWorlds = world->_nextWorldHash;
+  // Else, take the next world in the head block
+  } else {
+    // If there is no block or the head block is full, add a new block
+    if (that->_blocks == NULL || 
+      that->_nbUsedInBlock == MF_NBWORLDPERPOOLBLOCK) {
+      MFWorldPoolBlock* block = 
+        PBErrMalloc(MiniFrameErr, sizeof(MFWorldPoolBlock));
+      block->_next = that->_blocks;
+      that->_blocks = block;
+      that->_nbUsedInBlock = 0;
+    }
+    world = that->_blocks->_worlds + that->_nbUsedInBlock;
+    ++(that->_nbUsedInBlock);
+  }
+  // Return the world
+  return world;
+}
+
+// Give back the memory of the MFWorld 'world' to the MFWorldPool 
+// 'that' for later reuse
+void MFWorldPoolRelease(MFWorldPool* const that, MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
   }
-#if MF_LIMITDEPTH
-  // Declare a variable to memorize the limit of expansion by depth
-  int limitDepthExpansion = 
-    MFCurWorld(that)->_depth + MFGetMaxDepthExp(that);
-#endif
-  // Loop until we have time for one more step of expansion or there
-  // is no world to expand
-  // Take care of clock() wrapping around
-  while (timeUsed + maxTimeOneStep < MFGetMaxTimeExpansion(that) &&
-    GSetNbElem(MFWorldsToExpand(that)) > 0 &&
-    timeUsed >= 0.0) {
-    // Declare a variable to memorize the time at the beginning of one
-    // step of expansion
-    clock_t clockStartLoop = clock();
-    // Drop the world to expand with highest value
-    MFWorld* worldToExpand = GSetDrop((GSet*)MFWorldsToExpand(that));
-    // If this world is disposable
-    if (worldToExpand != MFCurWorld(that) && (
-      GSetNbElem(MFWorldSources(worldToExpand)) == 0 || 
-      MFModelStatusIsDisposable(MFWorldStatus(worldToExpand), 
-      MFWorldStatus(MFCurWorld(that))))) {
-      // Free this world
-      MFWorldFree(&worldToExpand);
-    // Else, if this world is under the limit by depth of expansion 
-    // it needs to be expanded
-    } else 
-#if MF_LIMITDEPTH
-      if (worldToExpand->_depth <= limitDepthExpansion) 
-#endif
-    {
-      // For each transitions from the expanded world and until we have
-      // time available
-      // Take care of clock() wrapping around
-      for (int iTrans = 0; iTrans < MFWorldGetNbTrans(worldToExpand) &&
-        timeUsed + maxTimeOneStep < MFGetMaxTimeExpansion(that) && 
-        timeUsed >= 0.0;
-        ++iTrans) {
-        // If this transition is expandable
-        const MFTransition* const trans = 
-          MFWorldTransition(worldToExpand, iTrans);
-        if (MFTransitionIsExpandable(trans)) {
-          // Expand through this transition
-          MFModelStatus status = 
-            MFWorldComputeTransition(worldToExpand, iTrans);
-#if MF_REUSEWORLD
-          // Search if the resulting status has already been computed,
-          // MFSearchWorld always return NULL if the reuse mode
-          // is false
-          MFWorld* sameWorld = MFSearchWorld(that, &status);
 #endif
-#if MF_USETELEMETRY
-          // Increment the number of worlds searched for reuse
-          ++nbWorldSearchForReuse;
+  // Add the world at the head of the list of released worlds
+  world->_nextWorldHash = that->_freeWorlds;
+  that->_freeWorlds = world;
+}
+
+// Create a new static MFFrontier, whose worlds are sorted by priority
+// if 'isSorted' is true, else expanded in their order of insertion
+// Return the new MFFrontier
+MFFrontier MFFrontierCreateStatic(const bool isSorted) {
+  // Declare the new MFFrontier
+  MFFrontier that;
+  // Set properties, only the storage used by the frontier is allocated
+  that._isSorted = isSorted;
+  that._nbAlloc = MF_NBINITFRONTIER;
+  that._elems = NULL;
+  that._worlds = NULL;
+  if (isSorted)
+    that._elems = 
+      PBErrMalloc(MiniFrameErr, sizeof(MFFrontierElem) * that._nbAlloc);
+  else
+    that._worlds = 
+      PBErrMalloc(MiniFrameErr, sizeof(MFWorld*) * that._nbAlloc);
+  that._nbInsert = 0;
+  that._head = 0;
+  that._nbWorld = 0;
+  // Return the new MFFrontier
+  return that;
+}
+
+// Free the memory used by the properties of the MFFrontier 'that'
+// The worlds in the frontier are not freed
+void MFFrontierFreeStatic(MFFrontier* const that) {
+  // Check argument
+  if (that == NULL) return;
+  // Free memory
+  free(that->_elems);
+  that->_elems = NULL;
+  free(that->_worlds);
+  that->_worlds = NULL;
+  that->_head = 0;
+  that->_nbWorld = 0;
+  that->_nbAlloc = 0;
+}
+
+// Return true if the 'iElem'-th element of the MFFrontier 'that' 
+// must be expanded before its 'jElem'-th element, else false
+#if BUILDMODE != 0
+static inline
 #endif
-#if MF_REUSEWORLD
-          // If there is no world to reuse
-          if (sameWorld == NULL) {
+bool MFFrontierIsBefore(const MFFrontier* const that, const int iElem,
+  const int jElem) {
+  // Declare two variables to memorize the compared elements
+  const MFFrontierElem* const elemA = that->_elems + iElem;
+  const MFFrontierElem* const elemB = that->_elems + jElem;
+  // Return the result of the comparison
+  return (elemA->_priority > elemB->_priority || 
+    (elemA->_priority == elemB->_priority && 
+    elemA->_order > elemB->_order));
+}
+
+// Swap the 'iElem'-th and 'jElem'-th elements of the MFFrontier 'that'
+#if BUILDMODE != 0
+static inline
 #endif
-            // Create a MFWorld for the new status
-            MFWorld* expandedWorld = MFWorldCreate(&status);
-            // Update the depth of the world
-            expandedWorld->_depth = worldToExpand->_depth + 1;
-#if MF_USETELEMETRY
-            if (that->_maxDepthExpReached < expandedWorld->_depth)
-              that->_maxDepthExpReached = expandedWorld->_depth;
+void MFFrontierSwap(MFFrontier* const that, const int iElem,
+  const int jElem) {
+  MFFrontierElem elem = that->_elems[iElem];
+  that->_elems[iElem] = that->_elems[jElem];
+  that->_elems[jElem] = elem;
+}
+
+// Move up the 'iElem'-th element of the MFFrontier 'that' until the 
+// heap property is restored
+void MFFrontierSiftUp(MFFrontier* const that, int iElem) {
+  // Loop until the element reaches the root or its parent is before it
+  while (iElem > 0) {
+    // Declare a variable to memorize the index of the parent
+    int iParent = (iElem - 1) / 2;
+    if (!MFFrontierIsBefore(that, iElem, iParent))
+      break;
+    MFFrontierSwap(that, iElem, iParent);
+    iElem = iParent;
+  }
+}
+
+// Move down the 'iElem'-th element of the MFFrontier 'that' until the 
+// heap property is restored
+void MFFrontierSiftDown(MFFrontier* const that, int iElem) {
+  // Loop until the element is before its children
+  while (true) {
+    // Declare a variable to memorize the index of the element to be 
+    // at position 'iElem' among the element and its children
+    int iFirst = iElem;
+    int iChild = 2 * iElem + 1;
+    if (iChild < that->_nbWorld && 
+      MFFrontierIsBefore(that, iChild, iFirst))
+      iFirst = iChild;
+    ++iChild;
+    if (iChild < that->_nbWorld && 
+      MFFrontierIsBefore(that, iChild, iFirst))
+      iFirst = iChild;
+    if (iFirst == iElem)
+      break;
+    MFFrontierSwap(that, iElem, iFirst);
+    iElem = iFirst;
+  }
+}
+
+// Add the MFWorld 'world' to the MFFrontier 'that' with the priority 
+// 'priority', worlds with highest priority are expanded first
+void MFFrontierPushSort(MFFrontier* const that, MFWorld* const world,
+  const float priority) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (!that->_isSorted) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'that' is not sorted");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // If the array of elements is full, double its size
+  if (that->_nbWorld == that->_nbAlloc) {
+    MFFrontierElem* elems = PBErrMalloc(MiniFrameErr, 
+      sizeof(MFFrontierElem) * 2 * that->_nbAlloc);
+    memcpy(elems, that->_elems, sizeof(MFFrontierElem) * that->_nbAlloc);
+    free(that->_elems);
+    that->_elems = elems;
+    that->_nbAlloc *= 2;
+  }
+  // Add the world at the end of the heap and move it up to its place
+  MFFrontierElem* elem = that->_elems + that->_nbWorld;
+  elem->_world = world;
+  elem->_priority = priority;
+  elem->_order = that->_nbInsert;
+  ++(that->_nbInsert);
+  ++(that->_nbWorld);
+  MFFrontierSiftUp(that, that->_nbWorld - 1);
+}
+
+// Double the size of the ring buffer of the MFFrontier 'that', the 
+// worlds are moved at the beginning of the new array
+void MFFrontierGrow(MFFrontier* const that) {
+  // Allocate the new array
+  MFWorld** worlds = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFWorld*) * 2 * that->_nbAlloc);
+  // Copy the worlds in their order, in two parts if they wrap around
+  // the end of the current array
+  int nbTail = that->_nbAlloc - that->_head;
+  if (nbTail > that->_nbWorld)
+    nbTail = that->_nbWorld;
+  memcpy(worlds, that->_worlds + that->_head, sizeof(MFWorld*) * nbTail);
+  memcpy(worlds + nbTail, that->_worlds, 
+    sizeof(MFWorld*) * (that->_nbWorld - nbTail));
+  // Replace the current array
+  free(that->_worlds);
+  that->_worlds = worlds;
+  that->_head = 0;
+  that->_nbAlloc *= 2;
+}
+
+// Add the MFWorld 'world' to the MFFrontier 'that' as the last one to
+// be expanded
+void MFFrontierPushLast(MFFrontier* const that, MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (that->_isSorted) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'that' is sorted");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // If the ring buffer is full, double its size
+  if (that->_nbWorld == that->_nbAlloc)
+    MFFrontierGrow(that);
+  // Add the world before the first one
+  that->_head = (that->_head - 1) & (that->_nbAlloc - 1);
+  that->_worlds[that->_head] = world;
+  ++(that->_nbWorld);
+}
+
+// Add the MFWorld 'world' to the MFFrontier 'that' as the next one to
+// be expanded
+void MFFrontierPushNext(MFFrontier* const that, MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (that->_isSorted) {
+    MFFrontierPushSort(that, world, FLT_MAX);
+  } else {
+    // If the ring buffer is full, double its size
+    if (that->_nbWorld == that->_nbAlloc)
+      MFFrontierGrow(that);
+    // Add the world after the last one
+    that->_worlds[(that->_head + that->_nbWorld) & 
+      (that->_nbAlloc - 1)] = world;
+    ++(that->_nbWorld);
+  }
+}
+
+// Remove the next world to be expanded from the MFFrontier 'that'
+// Return the removed world
+MFWorld* MFFrontierPop(MFFrontier* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (MFFrontierGetNb(that) == 0) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'that' is empty");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (that->_isSorted)
+    return MFFrontierRemove(that, 0);
+  // Remove the last world
+  --(that->_nbWorld);
+  return 
+    that->_worlds[(that->_head + that->_nbWorld) & (that->_nbAlloc - 1)];
+}
+
+// Remove the 'iWorld'-th world from the MFFrontier 'that'
+// Return the removed world
+MFWorld* MFFrontierRemove(MFFrontier* const that, const int iWorld) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iWorld < 0 || iWorld >= MFFrontierGetNb(that)) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iWorld' is invalid (0<=%d<%d)",
+      iWorld, MFFrontierGetNb(that));
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Declare a variable to memorize the removed world
+  MFWorld* world = MFFrontierGet(that, iWorld);
+  if (that->_isSorted) {
+    // Replace the removed element by the last one of the heap and move
+    // it to its place
+    --(that->_nbWorld);
+    if (iWorld < that->_nbWorld) {
+      that->_elems[iWorld] = that->_elems[that->_nbWorld];
+      MFFrontierSiftUp(that, iWorld);
+      MFFrontierSiftDown(that, iWorld);
+    }
+  } else {
+    // Shift the following worlds to fill the gap
+    int mask = that->_nbAlloc - 1;
+    for (int jWorld = iWorld + 1; jWorld < that->_nbWorld; ++jWorld)
+      that->_worlds[(that->_head + jWorld - 1) & mask] = 
+        that->_worlds[(that->_head + jWorld) & mask];
+    --(that->_nbWorld);
+  }
+  // Return the removed world
+  return world;
+}
+
+// Get the memory for an array of 'nb' MFTransition from the 
+// MFWorldPool 'that', 'nb' must be in 
+// [1, MF_NBMAXTRANSITION + MF_NBTRANSHEADER]
+// Released arrays of same size are reused first
+// Return the uninitialised array
+MFTransition* MFWorldPoolAllocTrans(MFWorldPool* const that, 
+  const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (nb < 1 || nb > MF_NBMAXTRANSITION + MF_NBTRANSHEADER) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'nb' is invalid (1<=%d<=%d)",
+      nb, MF_NBMAXTRANSITION + MF_NBTRANSHEADER);
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Declare a variable to memorize the returned array
+  MFTransition* transitions = NULL;
+  // If there is a released array of same size, reuse it
+  // The first bytes of a released array memorize the next released 
+  // array of same size
+  if (that->_freeTransitions[nb] != NULL) {
+    transitions = that->_freeTransitions[nb];
+    that->_freeTransitions[nb] = *(MFTransition**)transitions;
+  // Else, take the next transitions in the head block
+  } else {
+    // If there is no block or not enough room in the head block, add 
+    // a new block
+    if (that->_transBlocks == NULL || 
+      that->_nbUsedInTransBlock + nb > MF_NBTRANSPERPOOLBLOCK) {
+      // Keep the end of the head block for later reuse
+      int nbLeft = MF_NBTRANSPERPOOLBLOCK - that->_nbUsedInTransBlock;
+      if (that->_transBlocks != NULL && nbLeft > 0)
+        MFWorldPoolReleaseTrans(that, that->_transBlocks->_transitions + 
+          that->_nbUsedInTransBlock, nbLeft);
+      MFTransitionPoolBlock* block = 
+        PBErrMalloc(MiniFrameErr, sizeof(MFTransitionPoolBlock));
+      block->_next = that->_transBlocks;
+      that->_transBlocks = block;
+      that->_nbUsedInTransBlock = 0;
+    }
+    transitions = 
+      that->_transBlocks->_transitions + that->_nbUsedInTransBlock;
+    that->_nbUsedInTransBlock += nb;
+  }
+  // Return the array
+  return transitions;
+}
+
+// Give back the memory of the array of 'nb' MFTransition 
+// 'transitions' to the MFWorldPool 'that' for later reuse
+void MFWorldPoolReleaseTrans(MFWorldPool* const that, 
+  MFTransition* const transitions, const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (transitions == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'transitions' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (nb < 1 || nb > MF_NBMAXTRANSITION + MF_NBTRANSHEADER) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'nb' is invalid (1<=%d<=%d)",
+      nb, MF_NBMAXTRANSITION + MF_NBTRANSHEADER);
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Add the array at the head of the list of released arrays of same
+  // size
+  *(MFTransition**)transitions = that->_freeTransitions[nb];
+  that->_freeTransitions[nb] = transitions;
+}
+
+// Free memory used by properties of the MFTransition 'that'
+void MFTransitionFreeStatic(MFTransition* that) {
+  // Check argument
+  if (that == NULL) return;
+  // Free memory
+  MFModelTransitionFreeStatic(&(that->_transition));
+}
+
+// Return the time on the monotonic clock in millisecond
+double MFGetWallClockMs(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec) * 1000.0 + 
+    (double)(now.tv_nsec) / 1000000.0;
+}
+
+// Create a new static MFTimeManager, started now with no time to 
+// expand
+// Return the new MFTimeManager
+MFTimeManager MFTimeManagerCreateStatic(void) {
+  // Declare the new MFTimeManager
+  MFTimeManager that;
+  // Set properties
+  that._start = MFGetWallClockMs();
+  that._softDeadline = 0.0;
+  that._hardDeadline = 0.0;
+  that._stepCost = -1.0;
+  that._budget = 0.0;
+  that._iBestTrans = -1;
+  that._nbStableCheck = 0;
+  that._bestValue = 0.0;
+  that._volatility = 0.0;
+  // Return the new MFTimeManager
+  return that;
+}
+
+// Start the MFTimeManager 'that' at the time 'start', in millisecond 
+// on the monotonic clock
+void MFTimeManagerStart(MFTimeManager* const that, const double start) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_start = start;
+}
+
+// Set the soft and hard deadlines of the MFTimeManager 'that' to 
+// 'soft' and 'hard', in millisecond from its start
+// No step is started if it's predicted to end after the soft 
+// deadline, the step in progress is interrupted at the hard deadline
+void MFTimeManagerSetDeadlines(MFTimeManager* const that, 
+  const double soft, const double hard) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (soft > hard) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'soft' is invalid (%f<=%f)", 
+      soft, hard);
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_softDeadline = soft;
+  that->_hardDeadline = hard;
+  that->_budget = 0.0;
+  that->_iBestTrans = -1;
+  that->_nbStableCheck = 0;
+  that->_volatility = 0.0;
+}
+
+// Set the time planned for the expansion of the MFTimeManager 'that'
+// to 'budget' and its hard deadline to 'hard', in millisecond from its
+// start
+void MFTimeManagerSetBudget(MFTimeManager* const that, 
+  const double budget, const double hard) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MFTimeManagerSetDeadlines(that, MIN(budget, hard), hard);
+  that->_budget = MAX(budget, 0.0);
+}
+
+// Update the stability of the search of the MFTimeManager 'that' with
+// the index 'iBestTrans' of the best transition from the current 
+// world and its value 'bestValue', and adjust its soft deadline
+void MFTimeManagerCheckStability(MFTimeManager* const that, 
+  const int iBestTrans, const float bestValue) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (iBestTrans == -1)
+    return;
+  // The first check only memorizes the best transition
+  if (that->_iBestTrans != -1) {
+    if (that->_iBestTrans == iBestTrans)
+      ++(that->_nbStableCheck);
+    else
+      that->_nbStableCheck = 0;
+    that->_volatility += MF_GAMECLOCKRATE * 
+      (fabs(bestValue - that->_bestValue) - that->_volatility);
+    // The more stable the best transition the less time is needed, 
+    // the more volatile its value the more time is needed
+    double ratio = MAX(MF_GAMECLOCKMINFACTOR, 
+      MF_GAMECLOCKINSTABILITYFACTOR * 
+      pow(MF_GAMECLOCKSTABILITYDECAY, that->_nbStableCheck));
+    ratio *= 1.0 + MIN(1.0, 
+      that->_volatility / MF_GAMECLOCKVOLATILITYSCALE);
+    if (that->_budget > 0.0)
+      that->_softDeadline = 
+        MIN(that->_budget * ratio, that->_hardDeadline);
+  }
+  that->_iBestTrans = iBestTrans;
+  that->_bestValue = bestValue;
+}
+
+// Return true if the best transition from the current world of the 
+// search of the MFTimeManager 'that' is settled, given 'margin' its 
+// margin over the other transitions, else false
+bool MFTimeManagerIsSettled(const MFTimeManager* const that, 
+  const float margin, const float minMargin) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (minMargin < 0.0)
+    return false;
+  if (margin >= FLT_MAX)
+    return true;
+  return (that->_iBestTrans != -1 && 
+    that->_nbStableCheck >= MF_NBSTABLECHECKSETTLED &&
+    margin >= minMargin);
+}
+
+// Return the margin of the 'iBestTrans'-th of the 'nbTrans' 
+// transitions whose values are 'values' over the other ones, 
+// ignoring the ones leading to a proven world whose value is below 
+// the best one
+float MFTransitionsGetMargin(const int nbTrans, 
+  const float* const values, const bool* const isProven, 
+  const int iBestTrans) {
+#if BUILDMODE == 0
+  if (values == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'values' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (isProven == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'isProven' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iBestTrans < -1 || iBestTrans >= nbTrans) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iBestTrans' is invalid (-1<=%d<%d)",
+      iBestTrans, nbTrans);
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (iBestTrans == -1)
+    return -FLT_MAX;
+  float margin = FLT_MAX;
+  for (int iTrans = nbTrans; iTrans--;) {
+    if (iTrans != iBestTrans && (!isProven[iTrans] || 
+      values[iTrans] >= values[iBestTrans]))
+      margin = MIN(margin, values[iBestTrans] - values[iTrans]);
+  }
+  return margin;
+}
+
+// Return the time elapsed since the start of the MFTimeManager 'that',
+// in millisecond
+double MFTimeManagerGetElapsed(const MFTimeManager* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return MFGetWallClockMs() - that->_start;
+}
+
+// Return the time left until the hard deadline of the MFTimeManager 
+// 'that', in millisecond, negative if it's over
+double MFTimeManagerGetTimeLeft(const MFTimeManager* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return that->_hardDeadline - MFTimeManagerGetElapsed(that);
+}
+
+// Return true if a step of cost 'cost', in millisecond, started now 
+// ends before the soft deadline of the MFTimeManager 'that', else 
+// false
+bool MFTimeManagerHasTimeFor(const MFTimeManager* const that, 
+  const double cost) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return MFTimeManagerGetElapsed(that) + cost < that->_softDeadline;
+}
+
+// Return true if the hard deadline of the MFTimeManager 'that' is 
+// reached, else false
+bool MFTimeManagerIsOver(const MFTimeManager* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return MFTimeManagerGetElapsed(that) >= that->_hardDeadline;
+}
+
+// Return the predicted cost of the next step for the MFTimeManager 
+// 'that', in millisecond: the MF_STEPCOSTPERCENTILE percentile of the
+// costs of the previous steps, 0.0 if there was none
+double MFTimeManagerGetStepCost(const MFTimeManager* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return (that->_stepCost < 0.0 ? 0.0 : that->_stepCost);
+}
+
+// Update the running percentile of the costs of the steps of the 
+// MFTimeManager 'that' with the cost 'cost', in millisecond, of the 
+// last step
+// The percentile is estimated by stochastic approximation: it grows 
+// by a fraction MF_STEPCOSTPERCENTILE of the rate for each cost above 
+// it, and decreases by the complementary fraction for each cost below
+// it, so that it stabilises where MF_STEPCOSTPERCENTILE of the costs 
+// are below it, without memorizing the previous costs
+void MFTimeManagerAddStepCost(MFTimeManager* const that, 
+  const double cost) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // The first cost, or the first one above a null estimation, 
+  // initialises the estimation
+  if (that->_stepCost <= 0.0)
+    that->_stepCost = cost;
+  else if (cost > that->_stepCost)
+    that->_stepCost *= 1.0 + MF_STEPCOSTRATE * MF_STEPCOSTPERCENTILE;
+  else
+    that->_stepCost *= 
+      1.0 - MF_STEPCOSTRATE * (1.0 - MF_STEPCOSTPERCENTILE);
+}
+
+// Forget the costs of the previous steps of the MFTimeManager 'that'
+void MFTimeManagerResetStepCost(MFTimeManager* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_stepCost = -1.0;
+}
+
+// Create a new static MFExpansionWork with no work
+// Return the new MFExpansionWork
+MFExpansionWork MFExpansionWorkCreateStatic(void) {
+  // Declare the new MFExpansionWork
+  MFExpansionWork that;
+  // Set properties
+  that._nbExpandedWorld = 0;
+  that._nbEvaluation = 0;
+  that._nbPlayout = 0;
+  // Return the new MFExpansionWork
+  return that;
+}
+
+// Return true if the work 'that' is below the budget 'budget' for all
+// the kinds of work, else false
+bool MFExpansionWorkIsWithin(const MFExpansionWork* const that, 
+  const MFExpansionWork* const budget) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (budget == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'budget' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  return 
+    (budget->_nbExpandedWorld <= 0 || 
+    that->_nbExpandedWorld < budget->_nbExpandedWorld) &&
+    (budget->_nbEvaluation <= 0 || 
+    that->_nbEvaluation < budget->_nbEvaluation) &&
+    (budget->_nbPlayout <= 0 || 
+    that->_nbPlayout < budget->_nbPlayout);
+}
+
+// Add the work 'work' to the MFExpansionWork 'that'
+void MFExpansionWorkAdd(MFExpansionWork* const that, 
+  const MFExpansionWork* const work) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (work == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'work' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  that->_nbExpandedWorld += work->_nbExpandedWorld;
+  that->_nbEvaluation += work->_nbEvaluation;
+  that->_nbPlayout += work->_nbPlayout;
+}
+
+// Make sure the MiniFrame 'that' has at least 'nb' pools for the
+// worker threads
+void MFAllocThreadPools(MiniFrame* const that, const int nb) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (that->_nbThreadPool >= nb)
+    return;
+  // The pools are allocated one by one as the worlds keep a reference
+  // to their pool
+  MFWorldPool** pools =
+    PBErrMalloc(MiniFrameErr, sizeof(MFWorldPool*) * nb);
+  if (that->_nbThreadPool > 0)
+    memcpy(pools, that->_threadPools,
+      sizeof(MFWorldPool*) * that->_nbThreadPool);
+  for (int iPool = that->_nbThreadPool; iPool < nb; ++iPool) {
+    pools[iPool] = PBErrMalloc(MiniFrameErr, sizeof(MFWorldPool));
+    *(pools[iPool]) = MFWorldPoolCreateStatic();
+  }
+  free(that->_threadPools);
+  that->_threadPools = pools;
+  that->_nbThreadPool = nb;
+}
+
+// Start expanding the MiniFrame 'that' on a background thread until
+// MFStopPondering or MFSetCurWorld is called, typically during the
+// turn of the opponent
+void MFStartPondering(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (that->_expansionType == MFExpansionTypeAlphaBeta ||
+    MFIsPondering(that))
+    return;
+  atomic_store(&(that->_stopExpand), false);
+  // The flag is set before the creation of the thread, which reads it
+  that->_isPondering = true;
+  if (pthread_create(&(that->_ponderThread), NULL, MFPonder, that) != 0) {
+    MiniFrameErr->_type = PBErrTypeOther;
+    sprintf(MiniFrameErr->_msg, "pthread_create failed");
+    PBErrCatch(MiniFrameErr);
+  }
+}
+
+// Stop the pondering of the MiniFrame 'that' and wait for its
+// background thread to end
+// Do nothing if the MiniFrame is not pondering
+void MFStopPondering(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (!MFIsPondering(that))
+    return;
+  atomic_store(&(that->_stopExpand), true);
+  pthread_join(that->_ponderThread, NULL);
+  atomic_store(&(that->_stopExpand), false);
+  that->_isPondering = false;
+}
+
+// Expand the MiniFrame 'mf' until it's requested to stop
+// Used as the function of the pondering thread
+void* MFPonder(void* mf) {
+#if BUILDMODE == 0
+  if (mf == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'mf' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MiniFrame* const that = (MiniFrame*)mf;
+  // Expand by periods of the time limit of the MiniFrame, until the
+  // tree can't be expanded anymore
+  while (!atomic_load(&(that->_stopExpand))) {
+    MFTimeManagerStart(&(that->_timeManager), MFGetWallClockMs());
+    MFExpand(that);
+    if (that->_expansionType != MFExpansionTypeMCTS &&
+      MFGetNbWorldsToExpand(that) == 0)
+      break;
+  }
+  return NULL;
+}
+
+// Expand the MiniFrame 'that' until it reaches its time limit or can't 
+// expand anymore
+void MFExpand(MiniFrame* that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Dispatch to the expansion of the current type, the choice is made
+  // once per call and the loops of the expansions are specialised for
+  // their type
+  // The expansion may last until the time limit from the start clock,
+  // or the time allocated from the game clock
+  bool useGameClock = (MFUsesGameClock(that) && !MFIsPondering(that));
+  if (useGameClock)
+    MFAllocateTimeFromGameClock(that);
+  else
+    MFTimeManagerSetDeadlines(&(that->_timeManager), 
+      MFGetMaxTimeExpansion(that), MFGetMaxTimeExpansion(that));
+  // Count the work of this expansion from zero
+  that->_work = MFExpansionWorkCreateStatic();
+  // The MCTS and the alpha-beta update the best transitions of their 
+  // whole tree at once, their principal variation is rebuilt at the 
+  // next request, the other expansions maintain it while updating 
+  // backward the forecast values
+  switch (that->_expansionType) {
+    case MFExpansionTypeMCTS:
+      MFExpandMCTS(that);
+      that->_isPVValid = false;
+      break;
+    case MFExpansionTypeAlphaBeta:
+      MFExpandAlphaBeta(that);
+      that->_isPVValid = false;
+      break;
+    default:
+      MFExpandGraph(that);
+      break;
+  }
+  // Withdraw the time used from the game clock
+  if (useGameClock)
+    that->_gameClockTimeLeft += that->_gameClockIncrement - 
+      MFTimeManagerGetElapsed(&(that->_timeManager));
+}
+
+// Allocate the time of the next expansion of the MiniFrame 'that' 
+// from its game clock
+void MFAllocateTimeFromGameClock(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Update the average branching factor over the game
+  int nbTrans = MFWorldGetNbTrans(MFCurWorld(that));
+  if (that->_avgNbTrans <= 0.0)
+    that->_avgNbTrans = nbTrans;
+  else
+    that->_avgNbTrans += 
+      MF_GAMECLOCKRATE * ((float)nbTrans - that->_avgNbTrans);
+  // Spread the time left, minus the safety margin, over the next 
+  // moves, the increment is available for each of them
+  double timeLeft = 
+    MAX(0.0, that->_gameClockTimeLeft - MF_GAMECLOCKMARGIN);
+  double budget = timeLeft / MF_GAMECLOCKNBMOVE + 
+    that->_gameClockIncrement;
+  // The expansion can't go beyond a share of the time left, nor a 
+  // multiple of its budget
+  double hard = MIN(timeLeft, MIN(budget * MF_GAMECLOCKMAXFACTOR, 
+    timeLeft * MF_GAMECLOCKMAXSHARE + that->_gameClockIncrement));
+  // Scale the budget with the branching factor, a move without 
+  // alternative needs barely any time
+  if (nbTrans <= 1)
+    budget *= MF_GAMECLOCKFORCEDFACTOR;
+  else if (that->_avgNbTrans > 0.0)
+    budget *= sqrt((double)nbTrans / that->_avgNbTrans);
+  MFTimeManagerSetBudget(&(that->_timeManager), budget, hard);
+}
+
+// Expand the MiniFrame 'that' by one of the expansions memorizing the
+// graph of worlds in its frontier: by value, by width or by depth
+void MFExpandGraph(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the time manager of the expansion
+  MFTimeManager* const timeManager = &(that->_timeManager);
+#if MF_USETELEMETRY
+  that->_maxDepthExpReached = that->_curWorld->_depth;
+  // Declare a variable to memorize the number of reused worlds
+  int nbReusedWorld = 0;
+  // Declare a variable to memorize the number of worlds searched for 
+  // reuse
+  int nbWorldSearchForReuse = 0;
+#endif
+  // Declare a variable to memorize the nb of expanded worlds since the
+  // last update backward of the forecast values
+  int nbExpansionSinceBackprop = 0;
+  // Declare a variable to memorize the nb of steps since the last 
+  // check of the stability of the best transition, the first check 
+  // comes after the first step to stop at once if there is no 
+  // alternative
+  int nbStepSinceCheck = MF_NBSTEPPERSTABILITYCHECK - 1;
+  // If the expansion uses several threads, create the parallel 
+  // expansion
+  MFParallelExpansion* expansion = NULL;
+  if (MFGetNbThread(that) > 1)
+    expansion = MFParallelExpansionCreate(that);
+  // Ensure the set of world to expand is not empty
+  if (MFGetNbWorldsToExpand(that) == 0) {
+    that->_expByDepthAppendPos = 0;
+    MFAddWorldToExpand(that, MFCurWorld(that));
+    GSetRemoveFirst((GSet*)MFWorldsComputed(that), MFCurWorld(that));
+  }
+#if MF_LIMITDEPTH
+  // Declare a variable to memorize the limit of expansion by depth
+  int limitDepthExpansion = 
+    MFCurWorld(that)->_depth + MFGetMaxDepthExp(that);
+#endif
+  // Loop until we have time for one more step of expansion or the 
+  // budget of work is spent or there is no world to expand, or the 
+  // expansion is requested to stop
+  while (MFTimeManagerHasTimeFor(timeManager, 
+    MFTimeManagerGetStepCost(timeManager)) &&
+    MFExpansionWorkIsWithin(&(that->_work), &(that->_workBudget)) &&
+    MFGetNbWorldsToExpand(that) > 0 && 
+    !atomic_load(&(that->_stopExpand))) {
+    // If the hash table of worlds may become full during the step, 
+    // resize it now if there is time for it, as its cost grows with
+    // the nb of worlds and is not predicted by the previous steps
+    if (that->_nbWorldsHash + MF_NBMAXTRANSITION >= 
+      that->_nbBucketWorldsHash) {
+      if (!MFTimeManagerHasTimeFor(timeManager, 
+        that->_rehashCostPerWorld * (double)(that->_nbWorldsHash)))
+        break;
+      double timeStartRehash = MFGetWallClockMs();
+      MFResizeWorldHash(that, that->_nbBucketWorldsHash * 2);
+      if (that->_nbWorldsHash > 0)
+        that->_rehashCostPerWorld = 
+          (MFGetWallClockMs() - timeStartRehash) / 
+          (double)(that->_nbWorldsHash);
+    }
+    // Declare a variable to memorize the time at the beginning of one
+    // step of expansion
+    double timeStartLoop = MFGetWallClockMs();
+    // Declare a variable to memorize the worlds created in advance from
+    // the world to expand
+    MFPrefetchedWorld* prefetched = NULL;
+    // If the expansion is parallel, make sure the worlds reached from
+    // the next world to expand have been created
+    if (expansion != NULL) {
+#if MF_LIMITDEPTH
+      MFParallelExpansionPrefetch(expansion, that, limitDepthExpansion);
+#else
+      MFParallelExpansionPrefetch(expansion, that, 0);
+#endif
+    }
+    // Drop the world to expand with highest value
+    MFWorld* worldToExpand = MFFrontierPop(&(that->_worldsToExpand));
+    if (expansion != NULL)
+      prefetched = MFParallelExpansionGet(expansion, worldToExpand);
+    // If this world is disposable
+    if (worldToExpand != MFCurWorld(that) && (
+      MFWorldGetNbSource(worldToExpand) == 0 || 
+      MFModelStatusIsDisposable(MFWorldStatus(worldToExpand), 
+      MFWorldStatus(MFCurWorld(that))))) {
+      // Free this world
+      if (MFWorldIsOnPV(that, worldToExpand))
+        that->_isPVValid = false;
+      MFRemoveWorldFromHash(that, worldToExpand);
+      MFWorldFree(&worldToExpand);
+    // Else, if this world is under the limit by depth of expansion 
+    // it needs to be expanded
+    } else 
+#if MF_LIMITDEPTH
+      if (worldToExpand->_depth <= limitDepthExpansion) 
+#endif
+    {
+      // For each transitions from the expanded world, the step is not
+      // interrupted by the hard deadline as it's short and the world 
+      // would stay partially expanded
+      for (int iTrans = 0; iTrans < MFWorldGetNbTrans(worldToExpand);
+        ++iTrans) {
+        // If this transition is expandable
+        const MFTransition* const trans = 
+          MFWorldTransition(worldToExpand, iTrans);
+        if (MFTransitionIsExpandable(trans)) {
+          // Get the world reached through this transition if it has
+          // been created in advance, and take it from the prefetched 
+          // worlds
+          MFWorld* prefetchedWorld = NULL;
+          MFModelStatus status;
+          bool hasStatus = false;
+          if (prefetched != NULL) {
+            prefetchedWorld = prefetched->_toWorlds[iTrans];
+            prefetched->_toWorlds[iTrans] = NULL;
+            // Take the status computed in advance if its world hasn't 
+            // been created as it was to be reused
+            if (prefetched->_hasStatus[iTrans]) {
+              status = prefetched->_statuses[iTrans];
+              prefetched->_hasStatus[iTrans] = false;
+              hasStatus = true;
+            }
+          }
+          // Expand through this transition
+          if (prefetchedWorld == NULL && !hasStatus) {
+            status = MFWorldComputeTransition(worldToExpand, iTrans);
+            hasStatus = true;
+          }
+#if MF_REUSEWORLD
+          // Search if the resulting status has already been computed,
+          // MFSearchWorld always return NULL if the reuse mode
+          // is false
+          // The expanded world can't be reused as its own result
+          const MFModelStatus* const expandedStatus = 
+            (prefetchedWorld != NULL ? 
+            MFWorldStatus(prefetchedWorld) : &status);
+          MFWorld* sameWorld = 
+            MFSearchWorld(that, expandedStatus, worldToExpand);
+#endif
+#if MF_USETELEMETRY
+          // Increment the number of worlds searched for reuse
+          ++nbWorldSearchForReuse;
+#endif
+#if MF_REUSEWORLD
+          // If there is no world to reuse
+          if (sameWorld == NULL) {
+#endif
+            // Create a MFWorld for the new status, unless it has been
+            // created in advance
+            // The new world is evaluated at its creation, the worlds 
+            // created in advance have been counted by their thread
+            MFWorld* expandedWorld = prefetchedWorld;
+            if (expandedWorld == NULL) {
+              expandedWorld = 
+                MFWorldCreateFromPool(&(that->_worldPool), &status);
+              ++(that->_work._nbEvaluation);
+            }
+            // Update the depth of the world
+            expandedWorld->_depth = worldToExpand->_depth + 1;
+#if MF_USETELEMETRY
+            if (that->_maxDepthExpReached < expandedWorld->_depth)
+              that->_maxDepthExpReached = expandedWorld->_depth;
 #endif
 #if MF_USEPRUNING
             // If the expanded world is pruned
@@ -366,75 +1902,1131 @@ void MFExpand(MiniFrame* that) {
             } else {
 #endif
               // Add the world to the set of worlds to expand 
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK
               that->_expByDepthAppendPos = iTrans;
+              MFAddWorldToExpand(that, expandedWorld);
+#if MF_USEPRUNING
+            }
+#endif
+            // Set the expanded world as the result of the transition
+            MFWorldSetTransitionToWorld(
+              worldToExpand, iTrans, expandedWorld);
+#if MF_REUSEWORLD
+          } else {
+#if MF_USETELEMETRY
+            // Increment the number of reused world
+            ++nbReusedWorld;
+#endif
+            // Set the already computed one as the result of the 
+            // transition, the world created in advance is not needed
+            MFWorldSetTransitionToWorld(worldToExpand, iTrans, sameWorld);
+            MFWorldFree(&prefetchedWorld);
+          }
+#endif
+          // The world has its own copy of the status
+          if (hasStatus)
+            MFModelStatusFreeStatic(&status);
+        }
+      }
+      // Move the expanded world from the worlds to expands to the 
+      // computed worlds
+      MFAddWorldToComputed(that, worldToExpand);
+      ++(that->_work._nbExpandedWorld);
+      // The expanded world may extend the principal variation
+      MFCheckPV(that, worldToExpand);
+      // Update backward the forecast values for each transitions 
+      // leading to the expanded world according to its new transitions
+      // If they are updated by batch, mark the expanded world and 
+      // update them only once the batch is complete
+      if (MFGetNbExpansionPerBackprop(that) == 1) {
+        MFUpdateForecastValues(that, worldToExpand);
+      } else {
+        MFMarkWorldDirty(that, worldToExpand);
+        ++nbExpansionSinceBackprop;
+        if (nbExpansionSinceBackprop >= 
+          MFGetNbExpansionPerBackprop(that)) {
+          MFUpdateDirtyForecastValues(that);
+          nbExpansionSinceBackprop = 0;
+        }
+      }
+    }
+#if MF_LIMITDEPTH
+    // Else, the world is beyond the limit by depth of expansion, keep
+    // it unexpanded in the computed worlds like the pruned ones, else
+    // it would be lost out of the sets of worlds and never freed
+    else
+      MFAddWorldToComputed(that, worldToExpand);
+#endif
+    // Free the worlds created in advance and not used
+    MFPrefetchedWorldRelease(prefetched);
+    // Update the predicted cost of one step of expansion
+    MFTimeManagerAddStepCost(timeManager, 
+      MFGetWallClockMs() - timeStartLoop);
+    // Check the stability of the best transition from the current 
+    // world, and stop if it's settled
+    if (++nbStepSinceCheck >= MF_NBSTEPPERSTABILITYCHECK) {
+      const MFWorld* const curWorld = MFCurWorld(that);
+      int sente = MFModelStatusGetSente(MFWorldStatus(curWorld));
+      sente = (sente == -1 ? 0 : sente);
+      MFTimeManagerCheckStability(timeManager, 
+        curWorld->_iBestTrans[sente], 
+        MFWorldGetForecastValue(curWorld, sente));
+      nbStepSinceCheck = 0;
+      if (MFGetSettledMargin(that) >= 0.0 && 
+        MFGetNbMultiPV(that) == 1) {
+        float values[MF_NBMAXTRANSITION];
+        bool isProven[MF_NBMAXTRANSITION];
+        for (int iTrans = MFWorldGetNbTrans(curWorld); iTrans--;) {
+          const MFTransition* const trans = 
+            MFWorldTransition(curWorld, iTrans);
+          values[iTrans] = MFTransitionGetValue(trans, sente);
+          isProven[iTrans] = (MFTransitionIsExpanded(trans) && 
+            MFWorldIsEnd(MFTransitionToWorld(trans)));
+        }
+        float margin = MFTransitionsGetMargin(
+          MFWorldGetNbTrans(curWorld), values, isProven, 
+          curWorld->_iBestTrans[sente]);
+        if (MFTimeManagerIsSettled(timeManager, margin, 
+          MFGetSettledMargin(that)))
+          break;
+      }
+    }
+  }
+  MFParallelExpansionFree(&expansion);
+  // Update backward the forecast values for the worlds of the last 
+  // incomplete batch
+  MFUpdateDirtyForecastValues(that);
+#if MF_USETELEMETRY
+  // Telemetry for debugging
+  that->_timeUnusedExpansion = MFTimeManagerGetTimeLeft(timeManager);
+  if (nbWorldSearchForReuse > 0)
+    that->_percWorldReused = 
+      ((float)nbReusedWorld) / ((float)nbWorldSearchForReuse);
+  else
+    that->_percWorldReused = 0.0;
+#endif
+}
+
+// Create a new MFParallelExpansion for the MiniFrame 'mf' and start its
+// worker threads
+// Return the new MFParallelExpansion
+MFParallelExpansion* MFParallelExpansionCreate(MiniFrame* const mf) {
+#if BUILDMODE == 0
+  if (mf == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'mf' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Allocate memory
+  MFParallelExpansion* that =
+    PBErrMalloc(MiniFrameErr, sizeof(MFParallelExpansion));
+  // Set properties
+  that->_nbThread = MFGetNbThread(mf);
+  that->_nbPrefetched = MF_NBPREFETCHPERTHREAD * that->_nbThread;
+  that->_prefetched = PBErrMalloc(MiniFrameErr,
+    sizeof(MFPrefetchedWorld) * that->_nbPrefetched);
+  for (int iSlot = that->_nbPrefetched; iSlot--;)
+    that->_prefetched[iSlot]._world = NULL;
+  int nbAllocJob = that->_nbPrefetched * MF_NBMAXTRANSITION;
+  that->_jobs =
+    PBErrMalloc(MiniFrameErr, sizeof(MFExpansionJob) * nbAllocJob);
+  that->_nbJob = 0;
+  that->_isCreating = false;
+  that->_isOver = false;
+  pthread_barrier_init(&(that->_barrier), NULL, that->_nbThread);
+  // Create the threads, the calling thread allocates from the pool of
+  // the MiniFrame and the worker threads from their own pool
+  MFAllocThreadPools(mf, that->_nbThread - 1);
+  that->_threads = PBErrMalloc(MiniFrameErr,
+    sizeof(MFExpansionThread) * that->_nbThread);
+  for (int iThread = 0; iThread < that->_nbThread; ++iThread) {
+    MFExpansionThread* thread = that->_threads + iThread;
+    thread->_expansion = that;
+    thread->_pool = (iThread == 0 ?
+      &(mf->_worldPool) : mf->_threadPools[iThread - 1]);
+    thread->_jobs = PBErrMalloc(MiniFrameErr, sizeof(int) * nbAllocJob);
+    atomic_init(&(thread->_top), 0);
+    atomic_init(&(thread->_bottom), 0);
+    thread->_nbEvaluation = 0;
+    if (iThread > 0 && pthread_create(&(thread->_thread), NULL,
+      MFExpansionThreadMain, thread) != 0) {
+      MiniFrameErr->_type = PBErrTypeOther;
+      sprintf(MiniFrameErr->_msg, "pthread_create failed");
+      PBErrCatch(MiniFrameErr);
+    }
+  }
+  // Return the new parallel expansion
+  return that;
+}
+
+// Stop the worker threads and free the memory used by the
+// MFParallelExpansion 'that', including the worlds created in advance
+// and not used
+void MFParallelExpansionFree(MFParallelExpansion** that) {
+  // Check argument
+  if (that == NULL || *that == NULL) return;
+  // Stop the worker threads
+  (*that)->_isOver = true;
+  pthread_barrier_wait(&((*that)->_barrier));
+  for (int iThread = 1; iThread < (*that)->_nbThread; ++iThread)
+    pthread_join((*that)->_threads[iThread]._thread, NULL);
+  // Free memory
+  for (int iSlot = (*that)->_nbPrefetched; iSlot--;)
+    MFPrefetchedWorldRelease((*that)->_prefetched + iSlot);
+  for (int iThread = (*that)->_nbThread; iThread--;)
+    free((*that)->_threads[iThread]._jobs);
+  free((*that)->_threads);
+  pthread_barrier_destroy(&((*that)->_barrier));
+  free((*that)->_jobs);
+  free((*that)->_prefetched);
+  free(*that);
+  *that = NULL;
+}
+
+// Make sure the worlds reached from the next world of the frontier of
+// the MiniFrame 'mf' have been created by the MFParallelExpansion
+// 'that', if not create in parallel the ones of the next worlds of the
+// frontier whose depth is not over 'limitDepth'
+// The worlds created in advance are counted as evaluated by 'mf' even
+// if they are not used later
+void MFParallelExpansionPrefetch(MFParallelExpansion* const that,
+  MiniFrame* const mf, const int limitDepth) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (mf == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'mf' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
-              MFAddWorldToExpand(that, expandedWorld);
-#if MF_USEPRUNING
-            }
+  // If the next world has already been prefetched, there is nothing
+  // to do
+  const MFFrontier* const frontier = MFWorldsToExpand(mf);
+  int nbCandidate = MIN(MFFrontierGetNb(frontier), that->_nbPrefetched);
+  if (nbCandidate == 0 ||
+    MFParallelExpansionGet(that, MFFrontierPeek(frontier, 0)) != NULL)
+    return;
+  // Release the worlds prefetched from worlds which are not among the
+  // next ones anymore, which may happen when the frontier is sorted
+  for (int iSlot = that->_nbPrefetched; iSlot--;) {
+    MFPrefetchedWorld* const slot = that->_prefetched + iSlot;
+    if (slot->_world != NULL) {
+      bool isCandidate = false;
+      for (int iWorld = nbCandidate; iWorld-- && !isCandidate;)
+        isCandidate = (MFFrontierPeek(frontier, iWorld) == slot->_world);
+      if (!isCandidate)
+        MFPrefetchedWorldRelease(slot);
+    }
+  }
+  // Create the jobs for the candidates not yet prefetched, in free
+  // slots, in their order of expansion
+  that->_nbJob = 0;
+  int iSlot = 0;
+  for (int iWorld = 0; iWorld < nbCandidate; ++iWorld) {
+    MFWorld* const world = MFFrontierPeek(frontier, iWorld);
+#if MF_LIMITDEPTH
+    if (world->_depth > limitDepth)
+      continue;
+#else
+    (void)limitDepth;
 #endif
-            // Set the expanded world as the result of the transition
-            MFWorldSetTransitionToWorld(
-              worldToExpand, iTrans, expandedWorld);
+    if (MFParallelExpansionGet(that, world) != NULL)
+      continue;
+    while (iSlot < that->_nbPrefetched &&
+      that->_prefetched[iSlot]._world != NULL)
+      ++iSlot;
+    if (iSlot == that->_nbPrefetched)
+      break;
+    MFPrefetchedWorld* const slot = that->_prefetched + iSlot;
+    slot->_world = world;
+    for (int iTrans = MF_NBMAXTRANSITION; iTrans--;) {
+      slot->_toWorlds[iTrans] = NULL;
+      slot->_hasStatus[iTrans] = false;
+    }
+    for (int iTrans = 0; iTrans < MFWorldGetNbTrans(world); ++iTrans) {
+      if (MFTransitionIsExpandable(MFWorldTransition(world, iTrans))) {
+        MFExpansionJob* const job = that->_jobs + that->_nbJob;
+        job->_fromWorld = world;
+        job->_iTrans = iTrans;
+        job->_slot = slot;
+        ++(that->_nbJob);
+      }
+    }
+  }
+  if (that->_nbJob == 0)
+    return;
+  // Compute in parallel the statuses reached by the jobs
+  that->_isCreating = false;
+  MFParallelExpansionRun(that);
 #if MF_REUSEWORLD
-          } else {
+  // Drop the jobs whose world would be reused when the worlds of the
+  // frontier are expanded in order, as it has already been computed or
+  // is reached by a previous job, to avoid evaluating it for nothing
+  // Their status stays in the slot for the calling thread
+  if (MFIsWorldReusable(mf)) {
+    int nbJob = 0;
+    for (int iJob = 0; iJob < that->_nbJob; ++iJob) {
+      const MFExpansionJob* const job = that->_jobs + iJob;
+      const MFModelStatus* const status = 
+        job->_slot->_statuses + job->_iTrans;
+      bool isReused = 
+        (MFSearchWorld(mf, status, job->_fromWorld) != NULL);
+      for (int jJob = 0; jJob < nbJob && !isReused; ++jJob) {
+        const MFExpansionJob* const prevJob = that->_jobs + jJob;
+        isReused = (prevJob->_hash == job->_hash &&
+          MFModelStatusIsSame(
+          prevJob->_slot->_statuses + prevJob->_iTrans, status));
+      }
+      if (!isReused) {
+        that->_jobs[nbJob] = *job;
+        ++nbJob;
+      }
+    }
+    that->_nbJob = nbJob;
+  }
+#endif
+  // Create in parallel the worlds of the remaining jobs
+  that->_isCreating = true;
+  MFParallelExpansionRun(that);
+  // Count the worlds created by the threads during the round
+  for (int iThread = that->_nbThread; iThread--;)
+    mf->_work._nbEvaluation += that->_threads[iThread]._nbEvaluation;
+}
+
+// Deal the jobs of the MFParallelExpansion 'that' to its threads and
+// run them in one round
+void MFParallelExpansionRun(MFParallelExpansion* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Deal the jobs to the threads
+  for (int iThread = that->_nbThread; iThread--;) {
+    atomic_store(&(that->_threads[iThread]._top), 0);
+    atomic_store(&(that->_threads[iThread]._bottom), 0);
+    that->_threads[iThread]._nbEvaluation = 0;
+  }
+  for (int iJob = 0; iJob < that->_nbJob; ++iJob) {
+    MFExpansionThread* const thread =
+      that->_threads + iJob % that->_nbThread;
+    long bottom = atomic_load(&(thread->_bottom));
+    thread->_jobs[bottom] = iJob;
+    atomic_store(&(thread->_bottom), bottom + 1);
+  }
+  // Run the round, the barriers ensure the worker threads see the jobs
+  // and the calling thread sees their results
+  pthread_barrier_wait(&(that->_barrier));
+  MFExpansionThreadRun(that->_threads);
+  pthread_barrier_wait(&(that->_barrier));
+}
+
+// Get the worlds created in advance by the MFParallelExpansion 'that'
+// from the MFWorld 'world'
+// Return null if there are none
+MFPrefetchedWorld* MFParallelExpansionGet(
+  MFParallelExpansion* const that, const MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  for (int iSlot = that->_nbPrefetched; iSlot--;)
+    if (that->_prefetched[iSlot]._world == world)
+      return that->_prefetched + iSlot;
+  return NULL;
+}
+
+// Free the worlds and statuses of the MFPrefetchedWorld 'that' which 
+// have not been used and free its slot
+void MFPrefetchedWorldRelease(MFPrefetchedWorld* const that) {
+  // Check argument
+  if (that == NULL || that->_world == NULL) return;
+  // The worlds are not linked to the graph yet, they can be freed
+  // directly
+  // The world of the frontier may have been freed already, hence all 
+  // the slots are checked
+  for (int iTrans = MF_NBMAXTRANSITION; iTrans--;) {
+    MFWorldFree(that->_toWorlds + iTrans);
+    if (that->_hasStatus[iTrans]) {
+      MFModelStatusFreeStatic(that->_statuses + iTrans);
+      that->_hasStatus[iTrans] = false;
+    }
+  }
+  that->_world = NULL;
+}
+
+// Run the jobs of the current round from the deque of the
+// MFExpansionThread 'that', then the ones stolen from the other threads
+void MFExpansionThreadRun(MFExpansionThread* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MFParallelExpansion* const expansion = that->_expansion;
+  int iThread = that - expansion->_threads;
+  // Loop until there is no more job, no job is added during a round so
+  // once all the deques have been seen empty the round is over
+  while (true) {
+    int iJob = MFExpansionThreadPop(that);
+    for (int iOther = 1; iJob == -1 && iOther < expansion->_nbThread;
+      ++iOther)
+      iJob = MFExpansionThreadSteal(expansion->_threads +
+        (iThread + iOther) % expansion->_nbThread);
+    if (iJob == -1)
+      break;
+    MFExpansionJob* const job = expansion->_jobs + iJob;
+    MFPrefetchedWorld* const slot = job->_slot;
+    MFModelStatus* const status = slot->_statuses + job->_iTrans;
+    // Create the world of the status reached by the transition of the 
+    // job, its status is not needed anymore
+    if (expansion->_isCreating) {
+      MFWorld* toWorld = MFWorldCreateFromPool(that->_pool, status);
+      // The new world has been evaluated at its creation
+      ++(that->_nbEvaluation);
+      toWorld->_depth = job->_fromWorld->_depth + 1;
+      slot->_toWorlds[job->_iTrans] = toWorld;
+      MFModelStatusFreeStatic(status);
+      slot->_hasStatus[job->_iTrans] = false;
+    // Else, compute this status
+    } else {
+      *status = MFWorldComputeTransition(job->_fromWorld, job->_iTrans);
+      slot->_hasStatus[job->_iTrans] = true;
+      job->_hash = MFModelStatusHash(status);
+    }
+  }
+}
+
+// Loop on the rounds of the parallel expansion until it's over
+// Used as the function of the worker threads
+void* MFExpansionThreadMain(void* thread) {
+#if BUILDMODE == 0
+  if (thread == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'thread' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MFExpansionThread* const that = (MFExpansionThread*)thread;
+  MFParallelExpansion* const expansion = that->_expansion;
+  while (true) {
+    pthread_barrier_wait(&(expansion->_barrier));
+    if (expansion->_isOver)
+      break;
+    MFExpansionThreadRun(that);
+    pthread_barrier_wait(&(expansion->_barrier));
+  }
+  return NULL;
+}
+
+// Pop the job at the bottom of the deque of the MFExpansionThread 'that'
+// Return its index, or -1 if the deque is empty
+int MFExpansionThreadPop(MFExpansionThread* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Reserve the bottom job before looking at the top, if they are the
+  // same job the thieves are raced for it on the top
+  long bottom = atomic_load(&(that->_bottom)) - 1;
+  atomic_store(&(that->_bottom), bottom);
+  long top = atomic_load(&(that->_top));
+  if (top > bottom) {
+    atomic_store(&(that->_bottom), bottom + 1);
+    return -1;
+  }
+  int iJob = that->_jobs[bottom];
+  if (top == bottom) {
+    if (!atomic_compare_exchange_strong(&(that->_top), &top, top + 1))
+      iJob = -1;
+    atomic_store(&(that->_bottom), bottom + 1);
+  }
+  return iJob;
+}
+
+// Steal the job at the top of the deque of the MFExpansionThread 'that'
+// Return its index, or -1 if the deque is empty
+int MFExpansionThreadSteal(MFExpansionThread* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Retry while another thread takes the top job first
+  while (true) {
+    long top = atomic_load(&(that->_top));
+    long bottom = atomic_load(&(that->_bottom));
+    if (top >= bottom)
+      return -1;
+    int iJob = that->_jobs[top];
+    if (atomic_compare_exchange_strong(&(that->_top), &top, top + 1))
+      return iJob;
+  }
+}
+
+// Expand the MiniFrame 'that' by Monte Carlo tree search
+void MFExpandMCTS(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (MFModelStatusGetSente(MFWorldStatus(MFCurWorld(that))) == -1) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, 
+      "MCTS doesn't work with undefined sente");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the root of the tree
+  MFWorld* const curWorld = (MFWorld*)MFCurWorld(that);
+  MFWorldCreateMCTSStats(curWorld);
+  // Get the nb of worker threads and if they share the tree of the
+  // calling thread
+  int nbWorker = MFGetNbThread(that) - 1;
+  bool isShared = (nbWorker > 0 && MFIsTreeParallel(that));
+  if (isShared)
+    MFAllocThreadPools(that, nbWorker);
+  // Create the tree searched by the calling thread, which persists
+  // between calls to MFExpand
+  MFMCTSTree tree = MFMCTSTreeCreateStatic(that, curWorld,
+    &(that->_worldPool), &(that->_worldsComputed));
+  tree._isShared = isShared;
+  MFMCTSTreeShareBudget(&tree, nbWorker + 1, 0);
+  // Create the trees of the worker threads and start them
+  MFMCTSTree* workers = NULL;
+  if (nbWorker > 0) {
+    workers = PBErrMalloc(MiniFrameErr, sizeof(MFMCTSTree) * nbWorker);
+    for (int iWorker = nbWorker; iWorker--;) {
+      workers[iWorker] = MFMCTSTreeCreateStatic(that, curWorld,
+        (isShared ? that->_threadPools[iWorker] : NULL), NULL);
+      workers[iWorker]._isShared = isShared;
+      MFMCTSTreeShareBudget(workers + iWorker, nbWorker + 1, 
+        iWorker + 1);
+      if (pthread_create(&(workers[iWorker]._thread), NULL,
+        MFMCTSTreeSearch, workers + iWorker) != 0) {
+        MiniFrameErr->_type = PBErrTypeOther;
+        sprintf(MiniFrameErr->_msg, "pthread_create failed");
+        PBErrCatch(MiniFrameErr);
+      }
+    }
+  }
+  // Search the tree in the calling thread
+  MFMCTSTreeSearch(&tree);
+  that->_work = tree._work;
+  // Keep the predicted cost of one iteration for the next expansion
+  that->_timeManager = tree._timeManager;
 #if MF_USETELEMETRY
-            // Increment the number of reused world
-            ++nbReusedWorld;
+  that->_maxDepthExpReached = tree._maxDepth;
 #endif
-            // Set the already computed one as the result of the 
-            // transition 
-            MFWorldSetTransitionToWorld(worldToExpand, iTrans, sameWorld);
+  // Wait for the worker threads
+  for (int iWorker = nbWorker; iWorker--;) {
+    MFMCTSTree* worker = workers + iWorker;
+    pthread_join(worker->_thread, NULL);
+    // If the tree is shared, add the worlds created by the worker to
+    // the tree of the MiniFrame
+    if (isShared) {
+      while (GSetNbElem(&(worker->_ownWorlds)) > 0)
+        GSetAppend(&(that->_worldsComputed),
+          GSetPop(&(worker->_ownWorlds)));
+    // Else, merge the statistics of the transitions from its root into
+    // the persistent tree
+    } else {
+      for (int iTrans = MFWorldGetNbTrans(curWorld); iTrans--;) {
+        const MFMCTSStats* const workerStats =
+          worker->_root->_mctsStats + iTrans;
+        if (workerStats->_nbVisit > 0) {
+          // If the transition has not been tried by the calling thread
+          // add its resulting world to the tree
+          MFTransition* const trans = curWorld->_transitions + iTrans;
+          MFMCTSStats* const stats = curWorld->_mctsStats + iTrans;
+          if (stats->_expandState == MF_MCTSNOTEXPANDED) {
+            MFModelStatus status =
+              MFWorldComputeTransition(curWorld, iTrans);
+            MFWorld* expandedWorld =
+              MFWorldCreateFromPool(&(that->_worldPool), &status);
+            MFWorldCreateMCTSStats(expandedWorld);
+            expandedWorld->_depth = curWorld->_depth + 1;
+            GSetAppend(&(that->_worldsComputed), expandedWorld);
+            MFWorldSetTransitionToWorld(curWorld, iTrans, expandedWorld);
+            stats->_expandState = MF_MCTSEXPANDED;
           }
+          stats->_nbVisit += workerStats->_nbVisit;
+          float avgValues[MF_NBMAXACTOR];
+          for (int iActor = MF_NBMAXACTOR; iActor--;) {
+            MFAtomicAddFloat(stats->_sumValues + iActor,
+              workerStats->_sumValues[iActor]);
+            avgValues[iActor] =
+              stats->_sumValues[iActor] / (float)(stats->_nbVisit);
+          }
+          MFTransitionUpdateValues(trans, avgValues);
+        }
+      }
+    }
+    MFExpansionWorkAdd(&(that->_work), &(worker->_work));
+#if MF_USETELEMETRY
+    if (that->_maxDepthExpReached < worker->_maxDepth)
+      that->_maxDepthExpReached = worker->_maxDepth;
+#endif
+    MFMCTSTreeFreeStatic(worker);
+  }
+  free(workers);
+  // If the tree has been shared, update the values of its worlds now
+  // that all the threads are over
+  if (isShared)
+    MFMCTSUpdateTreeValues(that);
+#if MF_USETELEMETRY
+  // Telemetry for debugging
+  that->_timeUnusedExpansion = 
+    MFTimeManagerGetTimeLeft(&(that->_timeManager));
+  that->_nbTryMTCS = that->_work._nbPlayout;
+#endif
+}
+
+// Create a new static MFMCTSTree for the MiniFrame 'mf' with the 
+// MFWorld 'root' allocated from the MFWorldPool 'pool' and memorized
+// in the GSet 'worlds'
+// If 'pool' is null the tree uses its own pool and set, and its root 
+// is a new world with the same status as 'root'
+// If only 'worlds' is null the tree memorizes the worlds it adds to 
+// 'root' in its own set
+// The tree is searched with a copy of the time manager of 'mf'
+// Return the new MFMCTSTree
+MFMCTSTree MFMCTSTreeCreateStatic(const MiniFrame* const mf,
+  MFWorld* const root, MFWorldPool* const pool, GSet* const worlds) {
+#if BUILDMODE == 0
+  if (mf == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'mf' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (root == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'root' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Declare the new tree
+  MFMCTSTree that;
+  // Set properties
+  that._mf = mf;
+  that._ownPool = MFWorldPoolCreateStatic();
+  that._ownWorlds = GSetCreateStatic();
+  that._pool = pool;
+  that._worlds = worlds;
+  that._root = (pool != NULL ? root : NULL);
+  that._isShared = false;
+  // Seed the random generator from the one of the calling thread, it 
+  // must not be null
+  that._rndState = ((unsigned int)rand() << 1) | 1u;
+  that._timeManager = mf->_timeManager;
+  that._work = MFExpansionWorkCreateStatic();
+  that._workBudget = mf->_workBudget;
+  that._maxDepth = root->_depth;
+  // Return the new tree
+  return that;
+}
+
+// Free the memory used by the worlds remaining in the own set of the
+// MFMCTSTree 'that' and its own pool
+void MFMCTSTreeFreeStatic(MFMCTSTree* const that) {
+  // Check argument
+  if (that == NULL) return;
+  // Free memory, all the worlds are freed at once
+  while (GSetNbElem(&(that->_ownWorlds)) > 0) {
+    MFWorld* world = GSetPop(&(that->_ownWorlds));
+    MFWorldFreeProperties(world);
+  }
+  MFWorldPoolFreeStatic(&(that->_ownPool));
+  that->_root = NULL;
+}
+
+// Return a random number in [0.0, 1.0] from the random generator of 
+// the MFMCTSTree 'that'
+float MFMCTSTreeRnd(MFMCTSTree* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Xorshift generator
+  unsigned int x = that->_rndState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  that->_rndState = x;
+  return (float)x / (float)UINT_MAX;
+}
+
+// Play out randomly from the MFWorld 'leafWorld' of the MFMCTSTree
+// 'that' until an end status or the max depth of expansion, and 
+// memorize the values of the reached status in 'values' (set to 0.0 
+// by the caller)
+// The playout steps bare MFModelStatus, generates their transitions 
+// only when one more step is needed and evaluates only the reached one
+void MFMCTSTreePlayout(MFMCTSTree* const that, 
+  const MFWorld* const leafWorld, float* const values) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (leafWorld == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'leafWorld' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (values == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'values' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Declare a variable to memorize the status reached by the playout,
+  // the leaf world's one until the first step
+  const MFModelStatus* reached = MFWorldStatus(leafWorld);
+  MFModelStatus status;
+  int nbStep = 0;
+  int maxStep = MFGetMaxDepthExp(that->_mf);
+  int nbTrans = MFWorldGetNbTrans(leafWorld);
+  // The first step uses the transitions already generated for the 
+  // leaf world
+  if (!MFWorldIsEnd(leafWorld) && nbStep < maxStep && nbTrans > 0) {
+    int iTrans = 
+      (int)round(MFMCTSTreeRnd(that) * (float)(nbTrans - 1));
+    status = MFWorldComputeTransition(leafWorld, iTrans);
+    reached = &status;
+    ++nbStep;
+    // Loop until we reach an end status or a limit of step
+    MFModelTransition transitions[MF_NBMAXTRANSITION];
+    while (nbStep < maxStep && !MFModelStatusIsEnd(&status)) {
+      MFModelStatusGetTrans(&status, transitions, &nbTrans);
+      if (nbTrans == 0)
+        break;
+      // Select randomly the next transition and apply it
+      iTrans = (int)round(MFMCTSTreeRnd(that) * (float)(nbTrans - 1));
+      MFModelStatus res = MFModelStatusStepEnd(&status);
+      res = MFModelStatusStep(&res, transitions + iTrans);
+      res = MFModelStatusStepInit(&res);
+      // Free the transitions and the previous status
+      for (int jTrans = nbTrans; jTrans--;)
+        MFModelTransitionFreeStatic(transitions + jTrans);
+      MFModelStatusFreeStatic(&status);
+      status = res;
+      ++nbStep;
+    }
+  }
+  // Get the values of the reached status
+  MFModelStatusGetValues(reached, values);
+  if (nbStep > 0)
+    MFModelStatusFreeStatic(&status);
+}
+
+// Iterate the MCTS on the MFMCTSTree 'tree' until its deadline
+// Used as the function of the worker threads
+void* MFMCTSTreeSearch(void* tree) {
+#if BUILDMODE == 0
+  if (tree == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'tree' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MFMCTSTree* const that = (MFMCTSTree*)tree;
+  // If the tree uses its own pool, create its root here so that the 
+  // worlds of the tree are allocated by the thread searching it
+  if (that->_pool == NULL)
+    that->_pool = &(that->_ownPool);
+  if (that->_worlds == NULL)
+    that->_worlds = &(that->_ownWorlds);
+  if (that->_root == NULL) {
+    that->_root = MFWorldCreateFromPool(that->_pool, 
+      MFWorldStatus(MFCurWorld(that->_mf)));
+    that->_root->_depth = MFCurWorld(that->_mf)->_depth;
+    MFWorldCreateMCTSStats(that->_root);
+    GSetAppend(that->_worlds, that->_root);
+  }
+  // Loop until we have time for one more iteration or the budget of 
+  // work is spent, or the expansion is requested to stop
+  MFTimeManager* const timeManager = &(that->_timeManager);
+  while (MFTimeManagerHasTimeFor(timeManager, 
+    MFTimeManagerGetStepCost(timeManager)) &&
+    MFExpansionWorkIsWithin(&(that->_work), &(that->_workBudget)) &&
+    !atomic_load(&(that->_mf->_stopExpand))) {
+    double start = MFGetWallClockMs();
+    MFMCTSTreeIterate(that);
+    MFTimeManagerAddStepCost(timeManager, MFGetWallClockMs() - start);
+    // Check the stability of the best transition from the root, and 
+    // stop if it's settled, the first check comes after the first 
+    // iteration to stop at once if there is no alternative
+    if ((that->_work._nbPlayout % MF_NBSTEPPERSTABILITYCHECK == 0 ||
+      that->_work._nbPlayout == 1) && 
+      MFMCTSTreeCheckStability(that))
+      break;
+  }
+  return NULL;
+}
+
+// Set the budget of work of the MFMCTSTree 'that' to its share of the
+// budget of its MiniFrame, as the 'iTree'-th of 'nbTree' trees 
+// searched at the same time
+void MFMCTSTreeShareBudget(MFMCTSTree* const that, const int nbTree,
+  const int iTree) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // The budget is split as equally as possible, each tree gets at 
+  // least one unit of the limited kinds of work as a budget of 0 
+  // means no limit
+  const MFExpansionWork* const budget = &(that->_mf->_workBudget);
+  if (budget->_nbExpandedWorld > 0)
+    that->_workBudget._nbExpandedWorld = MAX(1, 
+      (budget->_nbExpandedWorld + nbTree - 1 - iTree) / nbTree);
+  if (budget->_nbEvaluation > 0)
+    that->_workBudget._nbEvaluation = MAX(1, 
+      (budget->_nbEvaluation + nbTree - 1 - iTree) / nbTree);
+  if (budget->_nbPlayout > 0)
+    that->_workBudget._nbPlayout = MAX(1, 
+      (budget->_nbPlayout + nbTree - 1 - iTree) / nbTree);
+}
+
+// Update the stability of the search of the MFMCTSTree 'that' with 
+// the most visited transition from its root
+// Return true if this transition is settled, else false
+bool MFMCTSTreeCheckStability(MFMCTSTree* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the sente of the root
+  int sente = MFModelStatusGetSente(MFWorldStatus(that->_root));
+  sente = (sente == -1 ? 0 : sente);
+  // Search the most visited transition, the statistics may be updated
+  // at the same time by other threads if the tree is shared
+  // Memorize the average values of the transitions for the margin, a
+  // transition never tried can't be ignored, its value is unknown
+  int iBestTrans = -1;
+  long nbVisitBest = 0;
+  int nbTrans = MFWorldGetNbTrans(that->_root);
+  float values[MF_NBMAXTRANSITION];
+  bool isProven[MF_NBMAXTRANSITION];
+  for (int iTrans = nbTrans; iTrans--;) {
+    const MFMCTSStats* const stats = that->_root->_mctsStats + iTrans;
+    long nbVisit = atomic_load(&(stats->_nbVisit));
+    values[iTrans] = (nbVisit > 0 ? 
+      atomic_load(stats->_sumValues + sente) / (float)nbVisit : 
+      FLT_MAX);
+    isProven[iTrans] = 
+      (atomic_load(&(stats->_expandState)) == MF_MCTSEXPANDED &&
+      MFWorldIsEnd(that->_root->_transitions[iTrans]._toWorld));
+    if (nbVisit > nbVisitBest) {
+      iBestTrans = iTrans;
+      nbVisitBest = nbVisit;
+    }
+  }
+  MFTimeManagerCheckStability(&(that->_timeManager), iBestTrans, 
+    (iBestTrans == -1 ? 0.0 : values[iBestTrans]));
+  if (MFGetSettledMargin(that->_mf) < 0.0 || 
+    MFGetNbMultiPV(that->_mf) > 1)
+    return false;
+  return MFTimeManagerIsSettled(&(that->_timeManager), 
+    MFTransitionsGetMargin(nbTrans, values, isProven, iBestTrans),
+    MFGetSettledMargin(that->_mf));
+}
+
+// Run one iteration of the MCTS on the MFMCTSTree 'that': selection, 
+// expansion, playout and backup
+void MFMCTSTreeIterate(MFMCTSTree* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
+  // Select a path in the tree from the root until a transition
+  // which has never been tried or an end world
+  // A virtual loss is applied to the selected transitions until the
+  // backup, to spread the threads sharing the tree over different paths
+  MFWorld* leafWorld = that->_root;
+  while (!MFWorldIsEnd(leafWorld) && MFWorldGetNbTrans(leafWorld) > 0) {
+    // Get the sente of the world
+    // TODO: doesn't work for simultaneous game
+    int sente = MFModelStatusGetSente(MFWorldStatus(leafWorld));
+    sente = (sente == -1 ? 0 : sente);
+    // Search the first transition never tried, and the total nb of
+    // tries from this world
+    int iSelTrans = -1;
+    long nbTryWorld = 0;
+    MFMCTSStats* const stats = leafWorld->_mctsStats;
+    for (int iTrans = 0; iTrans < MFWorldGetNbTrans(leafWorld);
+      ++iTrans) {
+      if (iSelTrans == -1 &&
+        atomic_load(&(stats[iTrans]._expandState)) == MF_MCTSNOTEXPANDED)
+        iSelTrans = iTrans;
+      nbTryWorld += atomic_load(&(stats[iTrans]._nbVisit));
+    }
+    // If all the transitions have been tried, select among the ones
+    // whose world is available the one with the highest upper
+    // confidence bound
+    if (iSelTrans == -1) {
+      float valSelTrans = 0.0;
+      for (int iTrans = MFWorldGetNbTrans(leafWorld); iTrans--;) {
+        if (atomic_load(&(stats[iTrans]._expandState)) == 
+          MF_MCTSEXPANDED) {
+          float nbVisit = (float)atomic_load(&(stats[iTrans]._nbVisit));
+          float val = 
+            atomic_load(stats[iTrans]._sumValues + sente) / nbVisit +
+            sqrt(2.0 * log(nbTryWorld) / nbVisit);
+          if (iSelTrans == -1 || valSelTrans < val) {
+            iSelTrans = iTrans;
+            valSelTrans = val;
+          }
         }
       }
-      // Move the expanded world from the worlds to expands to the 
-      // computed worlds
-      MFAddWorldToComputed(that, worldToExpand);
-      // Update the total time used from beginning of expansion 
-      timeUsed = 
-        ((double)(clock() - clockStart)) / MF_MILLISECTOCLOCKS;
-      // Update backward the forecast values for each transitions 
-      // leading to the expanded world according to its new transitions
-#if MF_REUSEWORLD == true
-      GSet updatedWorld = GSetCreateStatic();
-      MFUpdateForecastValues(that, worldToExpand, 0, &updatedWorld);
-      GSetFlush(&updatedWorld);
-#else
-      MFUpdateForecastValues(that, worldToExpand, 0, NULL);
+      // If all the transitions are being expanded by other threads,
+      // stop the selection here
+      if (iSelTrans == -1)
+        break;
+      // Keep the best transitions from the root of similar accuracy
+      if (leafWorld == that->_root && MFGetNbMultiPV(that->_mf) > 1)
+        iSelTrans = MFMCTSSelectMultiPV(leafWorld, sente, iSelTrans, 
+          MFGetNbMultiPV(that->_mf));
+      atomic_fetch_add(&(stats[iSelTrans]._nbVisit), 1);
+      MFAtomicAddFloat(stats[iSelTrans]._sumValues + sente, 
+        -MF_MCTSVIRTUALLOSS);
+      leafWorld = leafWorld->_transitions[iSelTrans]._toWorld;
+    // Else, expand the tree through the transition never tried and
+    // stop the selection, unless another thread has started expanding
+    // it in the meantime
+    } else {
+      MFTransition* const trans = leafWorld->_transitions + iSelTrans;
+      int expandState = MF_MCTSNOTEXPANDED;
+      if (!atomic_compare_exchange_strong(
+        &(stats[iSelTrans]._expandState), &expandState, 
+        MF_MCTSEXPANDING))
+        break;
+      atomic_fetch_add(&(stats[iSelTrans]._nbVisit), 1);
+      MFAtomicAddFloat(stats[iSelTrans]._sumValues + sente, 
+        -MF_MCTSVIRTUALLOSS);
+      MFModelStatus status =
+        MFWorldComputeTransition(leafWorld, iSelTrans);
+      MFWorld* expandedWorld =
+        MFWorldCreateFromPool(that->_pool, &status);
+      MFWorldCreateMCTSStats(expandedWorld);
+      expandedWorld->_depth = leafWorld->_depth + 1;
+      if (that->_maxDepth < expandedWorld->_depth)
+        that->_maxDepth = expandedWorld->_depth;
+      GSetAppend(that->_worlds, expandedWorld);
+      // If the tree is shared, only link the worlds as other threads
+      // may be reading the world of the transition, its values and
+      // best transitions are updated at the end of the search
+      if (that->_isShared) {
+        trans->_toWorld = expandedWorld;
+        MFWorldAddSource(expandedWorld, trans);
+      } else {
+        MFWorldSetTransitionToWorld(leafWorld, iSelTrans, expandedWorld);
+      }
+      atomic_store(&(stats[iSelTrans]._expandState), MF_MCTSEXPANDED);
+      leafWorld = expandedWorld;
+      ++(that->_work._nbExpandedWorld);
+      ++(that->_work._nbEvaluation);
+      break;
+    }
+  }
+  // Play out from the leaf world
+  float values[MF_NBMAXACTOR] = {0.0};
+  MFMCTSTreePlayout(that, leafWorld, values);
+  ++(that->_work._nbEvaluation);
+  ++(that->_work._nbPlayout);
+  // Update the statistics of the transitions on the path from the
+  // root to the leaf world, and remove their virtual loss
+  for (MFWorld* world = leafWorld; world != that->_root;) {
+    MFTransition* const trans = (MFTransition*)MFWorldSource(world, 0);
+    world = (MFWorld*)MFTransitionFromWorld(trans);
+    MFMCTSStats* const stats = 
+      world->_mctsStats + (trans - world->_transitions);
+    int sente = MFModelStatusGetSente(MFWorldStatus(world));
+    sente = (sente == -1 ? 0 : sente);
+    for (int iActor = MF_NBMAXACTOR; iActor--;)
+      MFAtomicAddFloat(stats->_sumValues + iActor, values[iActor] +
+        (iActor == sente ? MF_MCTSVIRTUALLOSS : 0.0));
+    // If the tree is not shared, update the values of the transition
+    // to the average of the playouts through it
+    if (!that->_isShared) {
+      float avgValues[MF_NBMAXACTOR];
+      for (int iActor = MF_NBMAXACTOR; iActor--;)
+        avgValues[iActor] =
+          stats->_sumValues[iActor] / (float)(stats->_nbVisit);
+      MFTransitionUpdateValues(trans, avgValues);
+    }
+  }
+}
+
+// Select the transition to play out from the MFWorld 'root' of the
+// MCTS, given the transition 'iSelTrans' selected by upper confidence
+// bound for the actor 'sente'
+// If 'iSelTrans' is one of the 'nbPV' best transitions by average 
+// value, the least visited of them is selected instead
+// Return the index of the selected transition
+int MFMCTSSelectMultiPV(const MFWorld* const root, const int sente,
+  const int iSelTrans, const int nbPV) {
+#if BUILDMODE == 0
+  if (root == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'root' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iSelTrans < 0 || iSelTrans >= MFWorldGetNbTrans(root)) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iSelTrans' is invalid (0<=%d<%d)",
+      iSelTrans, MFWorldGetNbTrans(root));
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the average value and nb of visits of the transitions whose 
+  // world is available, the other ones can't be selected
+  MFMCTSStats* const stats = root->_mctsStats;
+  int nbTrans = MFWorldGetNbTrans(root);
+  float avgValues[MF_NBMAXTRANSITION];
+  long nbVisits[MF_NBMAXTRANSITION];
+  for (int iTrans = nbTrans; iTrans--;) {
+    nbVisits[iTrans] = 0;
+    avgValues[iTrans] = 0.0;
+    if (atomic_load(&(stats[iTrans]._expandState)) == MF_MCTSEXPANDED) {
+      nbVisits[iTrans] = atomic_load(&(stats[iTrans]._nbVisit));
+      if (nbVisits[iTrans] > 0)
+        avgValues[iTrans] = 
+          atomic_load(stats[iTrans]._sumValues + sente) / 
+          (float)nbVisits[iTrans];
+    }
+  }
+  // Get the rank of each transition by average value, a transition is
+  // among the best ones if less than 'nbPV' transitions have a better
+  // average value, or the same one and a lower index
+  int ranks[MF_NBMAXTRANSITION];
+  for (int iTrans = nbTrans; iTrans--;) {
+    ranks[iTrans] = 0;
+    for (int jTrans = nbTrans; jTrans--;)
+      if (nbVisits[jTrans] > 0 && 
+        (avgValues[iTrans] < avgValues[jTrans] || 
+        (avgValues[iTrans] == avgValues[jTrans] && jTrans < iTrans)))
+        ++(ranks[iTrans]);
+  }
+  // If the transition selected by upper confidence bound is not among
+  // the best ones, keep it
+  if (ranks[iSelTrans] >= nbPV)
+    return iSelTrans;
+  // Else, select the least visited of the best ones
+  int iMultiPVTrans = iSelTrans;
+  for (int iTrans = nbTrans; iTrans--;)
+    if (nbVisits[iTrans] > 0 && ranks[iTrans] < nbPV &&
+      nbVisits[iTrans] < nbVisits[iMultiPVTrans])
+      iMultiPVTrans = iTrans;
+  // Return the selected transition
+  return iMultiPVTrans;
+}
+
+// Add atomically 'val' to the float 'that'
+void MFAtomicAddFloat(_Atomic float* const that, const float val) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
-    }
-    // Declare a variable to memorize the time at the end of one
-    // step of expansion
-    clock_t clockEndLoop = clock();
-    // Calculate the time for this step
-    double timeOneStep = 
-      ((double)(clockEndLoop - clockStartLoop)) / MF_MILLISECTOCLOCKS;  
-    // Update max time used by one step
-    if (maxTimeOneStep < timeOneStep)
-      maxTimeOneStep = timeOneStep;
-    // Update the total time used from beginning of expansion 
-    timeUsed = 
-      ((double)(clockEndLoop - clockStart)) / MF_MILLISECTOCLOCKS;
+  float cur = atomic_load(that);
+  while (!atomic_compare_exchange_weak(that, &cur, cur + val));
+}
+
+// Create the statistics of the MCTS for the transitions of the MFWorld
+// 'that' when it's added to the tree of the MCTS
+// Do nothing if they already exist
+void MFWorldCreateMCTSStats(MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
   }
-#if MF_USETELEMETRY
-  // Update the total time used from beginning of expansion 
-  timeUsed = ((double)(clock() - clockStart)) / MF_MILLISECTOCLOCKS;
-  // Take care of clock() wrapping around
-  if (timeUsed < 0.0)
-    timeUsed = MFGetMaxTimeExpansion(that);
-  // Telemetry for debugging
-  that->_timeUnusedExpansion = MFGetMaxTimeExpansion(that) - timeUsed;
-  if (nbWorldSearchForReuse > 0)
-    that->_percWorldReused = 
-      ((float)nbReusedWorld) / ((float)nbWorldSearchForReuse);
-  else
-    that->_percWorldReused = 0.0;
 #endif
+  if (that->_mctsStats != NULL || MFWorldGetNbTrans(that) == 0)
+    return;
+  that->_mctsStats = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFMCTSStats) * MFWorldGetNbTrans(that));
+  for (int iTrans = MFWorldGetNbTrans(that); iTrans--;) {
+    MFMCTSStats* const stats = that->_mctsStats + iTrans;
+    atomic_init(&(stats->_nbVisit), 0);
+    for (int iActor = MF_NBMAXACTOR; iActor--;)
+      atomic_init(stats->_sumValues + iActor, 0.0);
+    atomic_init(&(stats->_expandState), MF_MCTSNOTEXPANDED);
+  }
 }
-#else
-void MFExpand(MiniFrame* that) {
+
+// Update the values, nb of end children and best transitions of all
+// the worlds of the tree of the MiniFrame 'that' from the statistics
+// of their transitions, after a search shared by several threads
+void MFMCTSUpdateTreeValues(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (MFGetNbComputedWorlds(that) == 0)
+    return;
+  GSetIterForward iter =
+    GSetIterForwardCreateStatic(MFWorldsComputed(that));
+  do {
+    MFWorld* world = GSetIterGet(&iter);
+    world->_nbEndChild = 0;
+    for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+      MFTransition* const trans = world->_transitions + iTrans;
+      const MFMCTSStats* const stats = world->_mctsStats + iTrans;
+      if (MFTransitionIsExpanded(trans) &&
+        MFWorldIsEnd(MFTransitionToWorld(trans)))
+        ++(world->_nbEndChild);
+      if (stats->_nbVisit > 0)
+        for (int iActor = MF_NBMAXACTOR; iActor--;)
+          trans->_values[iActor] =
+            stats->_sumValues[iActor] / (float)(stats->_nbVisit);
+    }
+    MFWorldResetBestTransition(world);
+  } while (GSetIterStep(&iter));
+}
+
+// Expand the MiniFrame 'that' by alpha-beta search from its current
+// world
+void MFExpandAlphaBeta(MiniFrame* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -444,118 +3036,304 @@ void MFExpand(MiniFrame* that) {
   if (MFModelStatusGetSente(MFWorldStatus(MFCurWorld(that))) == -1) {
     MiniFrameErr->_type = PBErrTypeInvalidArg;
     sprintf(MiniFrameErr->_msg, 
-      "MCTS doesn't work with undefined sente");
+      "Alpha-beta doesn't work with undefined sente");
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  // Declare a variable to memorize the time at beginning of the whole 
-  // expansion process
-  clock_t clockStart = MFGetStartExpandClock(that);
-  // Get the sente
-  int sente = MFModelStatusGetSente(MFWorldStatus(MFCurWorld(that)));
-  // Declare variables to compute the MCTS
-  float sumTrans[MF_NBMAXTRANSITION];
-  for (int iTrans = MF_NBMAXTRANSITION; iTrans--;) {
-    sumTrans[iTrans] = 0.0;
+  // Get the time manager of the expansion
+  MFTimeManager* const timeManager = &(that->_timeManager);
+  // Get the current world and its sente, from whose pov the search is
+  // done
+  MFWorld* const curWorld = (MFWorld*)MFCurWorld(that);
+  int sente = MFModelStatusGetSente(MFWorldStatus(curWorld));
+  that->_searchActor = sente;
+  that->_nbSearch = 0;
+  that->_isSearchAborted = false;
+  // Allocate the table of best transitions the first time the 
+  // alpha-beta is used, it is kept from one expansion to the next
+  if (that->_alphaBetaTable == NULL) {
+    that->_alphaBetaTable = PBErrMalloc(MiniFrameErr, 
+      sizeof(MFAlphaBetaEntry) * MF_NBALPHABETAENTRY);
+    for (int iEntry = MF_NBALPHABETAENTRY; iEntry--;)
+      that->_alphaBetaTable[iEntry]._iBestTrans = -1;
   }
-  float values[MF_NBMAXACTOR];
-  long nbTryTrans[MF_NBMAXTRANSITION] = {0};
-  long nbTry = 0;
-  int nbTrans = MFWorldGetNbTrans(MFCurWorld(that));
-  // Declare a variable to memorize the maximum time used for one 
-  // step of expansion
-  double maxTimeOneStep = 0.0;
-  // Declare a variable to memorize the time spent expanding
-  double timeUsed = 
-    ((double)(clock() - clockStart)) / MF_MILLISECTOCLOCKS;
-  // Loop until we have time for one more step of expansion or there
-  // is no world to expand
-  // Take care of clock() wrapping around
-  while (timeUsed + maxTimeOneStep < MFGetMaxTimeExpansion(that) &&
-    timeUsed >= 0.0) {
-    // Declare a variable to memorize the time at the beginning of one
-    // step of expansion
-    clock_t clockStartLoop = clock();
-    // Select the transition with the highest value so far
-    int bestTrans = -1;
-    float valBestTrans = 0.0;
-    for (int iTrans = nbTrans; iTrans--;) {
-      float val = 0.0;
-      if (nbTryTrans[iTrans] > 0 && nbTry > 0) {
-        val = sumTrans[iTrans] / (float)nbTryTrans[iTrans] + 
-          sqrt(2.0 * log(nbTry) / (float)nbTryTrans[iTrans]);
-      }
-      if (bestTrans < 0 || valBestTrans < val) {
-        bestTrans = iTrans;
-        valBestTrans = val;
+  // Declare variables to memorize the values of the transitions from 
+  // the current world and the best one, according to the last 
+  // completed iteration
+  int nbTrans = MFWorldGetNbTrans(curWorld);
+  float values[MF_NBMAXTRANSITION];
+  int iBestTrans = -1;
+  // Declare a variable to memorize the values of all the actors at the
+  // leaf of the principal variation of each transition
+  float leafValues[MF_NBMAXTRANSITION][MF_NBMAXACTOR];
+  // Declare a variable to memorize the order in which the transitions
+  // are searched, the best ones of the previous iteration first
+  int order[MF_NBMAXTRANSITION];
+  for (int iTrans = nbTrans; iTrans--;) {
+    values[iTrans] = -FLT_MAX;
+    order[iTrans] = iTrans;
+  }
+#if MF_USETELEMETRY
+  // Declare a variable to memorize the depth of the last completed 
+  // iteration
+  int depthReached = 0;
+#endif
+  // Declare a variable to memorize if the last completed iteration 
+  // has been cut by its depth
+  bool isSearchCut = true;
+  // Declare variables to memorize the time spent by the last two 
+  // completed iterations, from which the cost of the next one is 
+  // predicted
+  double costIter = 0.0;
+  double costPrevIter = 0.0;
+  // Search iteratively deeper until the max depth or the end of the 
+  // game in all branches is reached, or the next iteration is 
+  // predicted to end after the soft deadline, or the budget of work is
+  // spent, the iteration in progress is aborted at the hard deadline 
+  // or when the budget is spent
+  // The cost of an iteration grows with the depth by the same factor
+  // as the cost of the previous iteration
+  for (int depth = 1; depth <= MFGetMaxDepthExp(that) && 
+    isSearchCut && !that->_isSearchAborted &&
+    MFExpansionWorkIsWithin(&(that->_work), &(that->_workBudget)) &&
+    MFTimeManagerHasTimeFor(timeManager, (costPrevIter > 0.0 ? 
+    costIter * MAX(1.0, costIter / costPrevIter) : costIter)); 
+    ++depth) {
+    // Declare a variable to memorize the time at the beginning of the
+    // iteration
+    double startIter = MFGetWallClockMs();
+    // Declare variables to memorize the values of the transitions and 
+    // the best one for this iteration
+    float valuesIter[MF_NBMAXTRANSITION];
+    float leafValuesIter[MF_NBMAXTRANSITION][MF_NBMAXACTOR];
+    int iBestIter = -1;
+    int nbSearched = 0;
+    float alpha = -FLT_MAX;
+    that->_isSearchCut = false;
+    // Declare variables to memorize the best values of this iteration
+    // in decreasing order, the window is opened with the last one once
+    // there are as many as the nb of best lines kept resolved
+    float bestValues[MF_NBMAXTRANSITION];
+    int nbBestValue = 0;
+    int nbPV = MIN(MFGetNbMultiPV(that), nbTrans);
+    // Loop on the transitions in order
+    for (int iOrder = 0; iOrder < nbTrans; ++iOrder) {
+      int iTrans = order[iOrder];
+      valuesIter[iTrans] = -FLT_MAX;
+      for (int iActor = MF_NBMAXACTOR; iActor--;)
+        leafValuesIter[iTrans][iActor] = -FLT_MAX;
+      if (!that->_isSearchAborted) {
+        // Search the world resulting from this transition
+        MFModelStatus status = MFWorldComputeTransition(curWorld, iTrans);
+        float resValues[MF_NBMAXACTOR];
+        float val = MFSearchAlphaBeta(that, &status, depth - 1, alpha, 
+          FLT_MAX, resValues);
+        MFModelStatusFreeStatic(&status);
+        // If the search has not been interrupted
+        if (!that->_isSearchAborted) {
+          // The values of the transitions after the 'nbPV' best ones 
+          // are only upper bounds of their real values
+          valuesIter[iTrans] = val;
+          memcpy(leafValuesIter[iTrans], resValues, 
+            sizeof(float) * MF_NBMAXACTOR);
+          ++nbSearched;
+          if (iBestIter == -1 || valuesIter[iBestIter] < val)
+            iBestIter = iTrans;
+          int iBest = MIN(nbBestValue, nbPV - 1);
+          if (nbBestValue < nbPV || bestValues[iBest] < val) {
+            while (iBest > 0 && bestValues[iBest - 1] < val) {
+              bestValues[iBest] = bestValues[iBest - 1];
+              --iBest;
+            }
+            bestValues[iBest] = val;
+            nbBestValue = MIN(nbBestValue + 1, nbPV);
+          }
+          if (nbBestValue == nbPV)
+            alpha = bestValues[nbPV - 1];
+        }
       }
     }
-    // Make a copy of the curWorld
-    MFWorld expandedWorld = *(MFWorld*)MFCurWorld(that);
-    // Loop until we reach an end world or a limit of step
-    int nbStep = 0;
-    int iTrans = bestTrans;
-    int nbNextTrans = MFWorldGetNbTrans(&expandedWorld);
-    while (!MFModelStatusIsEnd(MFWorldStatus(&expandedWorld)) &&
-      nbStep < MFGetMaxDepthExp(that) && nbNextTrans > 0) {
-      // Apply the transition
-      MFModelStatus status = 
-        MFWorldComputeTransition(&expandedWorld, iTrans);
-      expandedWorld = MFWorldCreateStatic(&status);
-      // Select randomly the next transition
-      nbNextTrans = MFWorldGetNbTrans(&expandedWorld);
-      iTrans = (int)round(rnd() * (float)(nbNextTrans - 1));
-      // Increment the number of step
-      ++nbStep;
+    // If the iteration is complete, or if it's the first one and some
+    // transitions have been searched, keep its result
+    if (nbSearched == nbTrans || (iBestTrans == -1 && nbSearched > 0)) {
+      for (int iTrans = nbTrans; iTrans--;) {
+        values[iTrans] = valuesIter[iTrans];
+        memcpy(leafValues[iTrans], leafValuesIter[iTrans], 
+          sizeof(float) * MF_NBMAXACTOR);
+      }
+      iBestTrans = iBestIter;
+#if MF_USETELEMETRY
+      depthReached = depth;
+#endif
+      isSearchCut = that->_isSearchCut;
+      costPrevIter = costIter;
+      costIter = MFGetWallClockMs() - startIter;
+      // Sort the transitions by decreasing value for the next 
+      // iteration, the best one first
+      for (int iOrder = 1; iOrder < nbTrans; ++iOrder) {
+        int iTrans = order[iOrder];
+        int jOrder = iOrder;
+        while (jOrder > 0 && (iTrans == iBestTrans ||
+          (order[jOrder - 1] != iBestTrans &&
+          values[order[jOrder - 1]] < values[iTrans]))) {
+          order[jOrder] = order[jOrder - 1];
+          --jOrder;
+        }
+        order[jOrder] = iTrans;
+      }
+      // Check the stability of the best transition, and stop if it's
+      // settled
+      if (iBestTrans != -1) {
+        MFTimeManagerCheckStability(timeManager, iBestTrans, 
+          values[iBestTrans]);
+        bool isProven[MF_NBMAXTRANSITION] = {false};
+        if (MFGetNbMultiPV(that) == 1 && MFTimeManagerIsSettled(
+          timeManager, MFTransitionsGetMargin(nbTrans, values, 
+          isProven, iBestTrans), MFGetSettledMargin(that)))
+          break;
+      }
     }
-    // Get the value of the reached world for the current player
-    // TODO: doesn't work for simultaneous game
-    for (int iActor = MF_NBMAXACTOR; iActor--;)
-      values[iActor] = 0.0;
-    MFModelStatusGetValues(MFWorldStatus(&expandedWorld), values);
-    float val = values[sente];
-    // Update the variables for the MCTS
-    ++nbTry;
-    ++(nbTryTrans[bestTrans]);
-    sumTrans[bestTrans] += val;
-    // Declare a variable to memorize the time at the end of one
-    // step of expansion
-    clock_t clockEndLoop = clock();
-    // Calculate the time for this step
-    double timeOneStep = 
-      ((double)(clockEndLoop - clockStartLoop)) / MF_MILLISECTOCLOCKS;  
-    // Update max time used by one step
-    if (maxTimeOneStep < timeOneStep)
-      maxTimeOneStep = timeOneStep;
-    // Update the total time used from beginning of expansion 
-    timeUsed = 
-      ((double)(clockEndLoop - clockStart)) / MF_MILLISECTOCLOCKS;
-  }
-  // Update the values of the transitions
-  // TODO: doesn't work for simultaneous game
+  }
+  // Update the values of the transitions with the values of all the 
+  // actors at the leaf of their principal variation
   for (int iTrans = nbTrans; iTrans--;) {
     MFTransition* trans = 
-      (MFTransition*)MFWorldTransition(MFCurWorld(that), iTrans);
-    if (nbTryTrans[iTrans] > 0) {
-      trans->_values[sente] = 
-        sumTrans[iTrans] / (float)nbTryTrans[iTrans];
-    } else {
-      trans->_values[sente] = 0.0;
-    }
+      (MFTransition*)MFWorldTransition(curWorld, iTrans);
+    for (int iActor = MF_NBMAXACTOR; iActor--;)
+      trans->_values[iActor] = 
+        (iBestTrans == -1 ? 0.0 : leafValues[iTrans][iActor]);
   }
-  
+  // Update the best transition, which can't be deduced from the values
+  // as the other transitions may have the same upper bound
+  MFWorldResetBestTransition(curWorld);
+  if (iBestTrans != -1)
+    for (int iActor = MF_NBMAXACTOR; iActor--;)
+      curWorld->_iBestTrans[iActor] = iBestTrans;
 #if MF_USETELEMETRY
-  // Update the total time used from beginning of expansion 
-  timeUsed = ((double)(clock() - clockStart)) / MF_MILLISECTOCLOCKS;
-  // Take care of clock() wrapping around
-  if (timeUsed < 0.0)
-    timeUsed = MFGetMaxTimeExpansion(that);
   // Telemetry for debugging
-  that->_timeUnusedExpansion = MFGetMaxTimeExpansion(that) - timeUsed;
-  that->_nbTryMTCS = nbTry;
+  that->_timeUnusedExpansion = MFTimeManagerGetTimeLeft(timeManager);
+  that->_maxDepthExpReached = curWorld->_depth + depthReached;
 #endif
 }
+
+// Search by alpha-beta pruning the value of the MFModelStatus 'status'
+// from the pov of the searched actor of the MiniFrame 'that', up to 
+// 'depth' transitions and inside the window ['alpha', 'beta']
+// The sente maximises the value if it is the searched actor, else it
+// minimises it
+// The values of all the actors at the leaf of the principal variation
+// of the search are memorized in 'leafValues'
+// The transitions of a status are searched first from the best one of
+// its last search, memorized in the table of best transitions
+// If the time limit is reached the search is aborted and the returned
+// value is meaningless
+float MFSearchAlphaBeta(MiniFrame* const that, 
+  const MFModelStatus* const status, const int depth, float alpha, 
+  float beta, float* const leafValues) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (status == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'status' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (leafValues == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'leafValues' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
+  // Check regularly the hard deadline, and the budget of work
+  ++(that->_nbSearch);
+  if ((that->_nbSearch % MF_NBSEARCHPERCLOCKCHECK == 0 &&
+    MFTimeManagerIsOver(&(that->_timeManager))) ||
+    !MFExpansionWorkIsWithin(&(that->_work), &(that->_workBudget)))
+    that->_isSearchAborted = true;
+  if (that->_isSearchAborted)
+    return 0.0;
+  // Get the transitions from the status, if it's not a leaf
+  MFModelTransition transitions[MF_NBMAXTRANSITION];
+  int nbTrans = 0;
+  if (!MFModelStatusIsEnd(status)) {
+    if (depth > 0)
+      MFModelStatusGetTrans(status, transitions, &nbTrans);
+    else
+      that->_isSearchCut = true;
+  }
+  // If it's a leaf, return its value
+  if (nbTrans == 0) {
+    for (int iActor = MF_NBMAXACTOR; iActor--;)
+      leafValues[iActor] = 0.0;
+    MFModelStatusGetValues(status, leafValues);
+    ++(that->_work._nbEvaluation);
+    return leafValues[that->_searchActor];
+  }
+  // Get the entry of the status in the table of best transitions, and 
+  // order the transitions with the best one of its last search first
+  unsigned long hash = MFModelStatusHash(status);
+  MFAlphaBetaEntry* const entry = 
+    that->_alphaBetaTable + (hash & (MF_NBALPHABETAENTRY - 1));
+  int order[MF_NBMAXTRANSITION];
+  for (int iTrans = nbTrans; iTrans--;)
+    order[iTrans] = iTrans;
+  // The entry may be the one of another status with the same index, 
+  // or the same hash, it only changes the order of the search
+  if (entry->_hash == hash && entry->_iBestTrans > 0 &&
+    entry->_iBestTrans < nbTrans) {
+    order[0] = entry->_iBestTrans;
+    order[entry->_iBestTrans] = 0;
+  }
+  ++(that->_work._nbExpandedWorld);
+  // Get the sente, and if it maximises or minimises the value
+  bool isMax = 
+    (MFModelStatusGetSente(status) == that->_searchActor);
+  // Declare variables to memorize the best value and transition
+  float best = (isMax ? -FLT_MAX : FLT_MAX);
+  int iBestTrans = -1;
+  // Loop on transitions until the window is empty
+  for (int iOrder = 0; iOrder < nbTrans && alpha < beta &&
+    !that->_isSearchAborted; ++iOrder) {
+    int iTrans = order[iOrder];
+    // Search the status resulting from the transition
+    MFModelStatus res = MFModelStatusStepEnd(status);
+    res = MFModelStatusStep(&res, transitions + iTrans);
+    res = MFModelStatusStepInit(&res);
+    float resValues[MF_NBMAXACTOR];
+    float val = MFSearchAlphaBeta(that, &res, depth - 1, alpha, beta,
+      resValues);
+    MFModelStatusFreeStatic(&res);
+    // Update the best value, the values at the leaf of its principal 
+    // variation, and the window
+    if (iBestTrans == -1 || 
+      (isMax && best < val) || (!isMax && best > val)) {
+      best = val;
+      iBestTrans = iTrans;
+      memcpy(leafValues, resValues, sizeof(float) * MF_NBMAXACTOR);
+    }
+    if (isMax) {
+      if (alpha < best)
+        alpha = best;
+    } else {
+      if (beta > best)
+        beta = best;
+    }
+  }
+  // Memorize the best transition for the next search of the status, 
+  // unless the search has been interrupted
+  if (!that->_isSearchAborted) {
+    entry->_hash = hash;
+    entry->_iBestTrans = iBestTrans;
+  }
+  // Free memory
+  for (int iTrans = nbTrans; iTrans--;)
+    MFModelTransitionFreeStatic(transitions + iTrans);
+  // Return the best value
+  return best;
+}
 
 // Return true if the MFWorld 'that' should be pruned during search for
 // worlds to expand when reaching it through transition 'trans',
@@ -634,12 +3412,12 @@ bool MFWorldIsExpandable(const MFWorld* const that) {
 #endif
   // Declare a variable to memorize the result
   bool isExpandable = false;
-  // If we are not at the end
-  if (!MFModelStatusIsEnd(MFWorldStatus(that))) {
+  // If we are not at the end and no transition reaches an end world
+  if (!MFWorldIsEnd(that) && !MFWorldHasEndChild(that)) {
     // Loop on transitions
     for (int iTrans = that->_nbTransition; iTrans-- && !isExpandable;) {
       // If this transition has not been computed
-      if (MFTransitionIsExpandable(MFWorldTransition(that, iTrans)))
+      if (MFTransitionToWorld(MFWorldTransition(that, iTrans)) == NULL)
         isExpandable = true;
     }
   }
@@ -648,10 +3426,12 @@ bool MFWorldIsExpandable(const MFWorld* const that) {
 }
 
 // Search in computed worlds of the MiniFrame 'that' if there is 
-// one with same status as the MFModelStatus 'status'
+// one, other than 'excluded', with same status as the MFModelStatus 
+// 'status'
+// 'excluded' can be null
 // If there is one return it, if not return null
 MFWorld* MFSearchWorld(const MiniFrame* const that, 
-  const MFModelStatus* const status) {
+  const MFModelStatus* const status, const MFWorld* const excluded) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -668,29 +3448,18 @@ MFWorld* MFSearchWorld(const MiniFrame* const that,
   MFWorld* sameWorld = NULL;
   // If the reuse of worlds is activated
   if (MFIsWorldReusable(that)) {
-    if (MFGetNbComputedWorlds(that) > 0) {
-      // Loop on computed worlds
-      GSetIterForward iter = 
-        GSetIterForwardCreateStatic((GSet*)MFWorldsComputed(that));
-      do {
-        MFWorld* world = GSetIterGet(&iter);
-        // If this world is the same as the searched one
-        if (MFModelStatusIsSame(status, MFWorldStatus(world))) {
-          sameWorld = world;
-        }
-      } while (sameWorld == NULL && GSetIterStep(&iter));
-    }
-    if (sameWorld == NULL && MFGetNbWorldsToExpand(that) > 0) {
-      // Loop on worlds to expand
-      GSetIterForward iter = 
-        GSetIterForwardCreateStatic((GSet*)MFWorldsToExpand(that));
-      do {
-        MFWorld* world = GSetIterGet(&iter);
-        // If this world is the same as the searched one
-        if (MFModelStatusIsSame(status, MFWorldStatus(world))) {
-          sameWorld = world;
-        }
-      } while (sameWorld == NULL && GSetIterStep(&iter));
+    // Get the bucket of the searched status in the hash table
+    unsigned long hash = MFModelStatusHash(status);
+    MFWorld* world = that->_worldsHash[
+      hash & (unsigned long)(that->_nbBucketWorldsHash - 1)];
+    // Loop on the worlds in the bucket
+    while (sameWorld == NULL && world != NULL) {
+      // If this world is the same as the searched one
+      if (world != excluded && world->_hash == hash && 
+        MFModelStatusIsSame(status, MFWorldStatus(world))) {
+        sameWorld = world;
+      }
+      world = world->_nextWorldHash;
     }
   }
   // Return the found world
@@ -722,14 +3491,23 @@ void MFWorldSetTransitionToWorld(
 #endif
   // Declare a variable to memorize the transition
   MFTransition* trans = that->_transitions + iTrans;
+  // Declare a variable to memorize the values of the transition before
+  // update
+  float prevValues[MF_NBMAXACTOR];
+  memcpy(prevValues, trans->_values, sizeof(float) * MF_NBMAXACTOR);
   // Set the transition result
   trans->_toWorld = toWorld;
   // Add the transition to the sources to the result's world
-  GSetAppend(&(toWorld->_sources), trans);
+  MFWorldAddSource(toWorld, trans);
+  // Update the number of transitions reaching an end world
+  if (MFWorldIsEnd(toWorld))
+    ++(that->_nbEndChild);
   // Update the forecast value of this transition for each actor
   for (int iActor = MF_NBMAXACTOR; iActor--;)
     MFTransitionSetValue(trans, iActor, 
       MFWorldGetForecastValue(toWorld, iActor));
+  // Update the best transitions of the world
+  MFWorldUpdateBestTransition(that, iTrans, prevValues);
 }
 
 // Return true if the MFTransition 'that' is expandable, i.e. its
@@ -748,32 +3526,9 @@ bool MFTransitionIsExpandable(const MFTransition* const that) {
     return false;
   // Else, the transition has not been expanded yet
   } else {
-    // Get the origin of the transition
-    const MFWorld* fromWorld = MFTransitionFromWorld(that);
-    // Declare a variable to memorize if the transition has a brother
-    // which leads to an end world
-    bool hasEndWorldBrother = false;
-    // For each brother transition, until we have found an end world
-    for (int iTrans = MFWorldGetNbTrans(fromWorld); 
-      iTrans-- && !hasEndWorldBrother;) {
-      // Get the brother transition's toWorld
-      const MFWorld* brother = 
-        MFTransitionToWorld(MFWorldTransition(fromWorld, iTrans));
-      // If the brother world is an end world
-      if (brother != NULL &&
-        MFModelStatusIsEnd(MFWorldStatus(brother))) {
-        // Set the flag
-        hasEndWorldBrother = true;
-      }
-    }
-    // If the transition has a brother leading to an end world
-    if (hasEndWorldBrother)
-      // This transition is not expandable
-      return false;
-    // Else, the transition has no brother leading to an end world
-    else
-      // This transition is expandable
-      return true;
+    // The transition is expandable if it has no brother leading to an
+    // end world
+    return !MFWorldHasEndChild(MFTransitionFromWorld(that));
   }
 }
 
@@ -832,6 +3587,87 @@ const MFModelTransition* MFBestTransition(
   return MFWorldBestTransition(MFCurWorld(that), iActor);
 }
 
+// Get the 'nb' best transitions from the current world of the 
+// MiniFrame 'that', sorted by decreasing forecast value for the sente
+// of the current world, or for the 'iActor'-th actor if it has no 
+// sente, among the transitions considered by MFBestTransition()
+// The transitions are stored in 'transitions', which must have room 
+// for 'nb' transitions, their forecast values are available with 
+// MFTransitionGetValue()
+// With the alpha-beta expansion, only the values of the 
+// MFGetNbMultiPV() best transitions are exact
+// Return the nb of transitions stored, less than 'nb' if there are 
+// not enough transitions
+int MFGetBestTransitions(const MiniFrame* const that, const int iActor,
+  const int nb, const MFTransition** const transitions) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iActor < 0 || iActor >= MF_NBMAXACTOR) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iActor' is invalid (0<=%d<%d)",
+      iActor, MF_NBMAXACTOR);
+    PBErrCatch(MiniFrameErr);
+  }
+  if (transitions == NULL && nb > 0) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'transitions' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  const MFWorld* const world = MFCurWorld(that);
+  // Get the sente
+  int sente = MFModelStatusGetSente(MFWorldStatus(world));
+  sente = (sente == -1 ? iActor : sente);
+  // The alpha-beta expansion doesn't expand the transitions, all of 
+  // them are ranked once it has set the best transition
+  bool isAlphaBeta = 
+    (MFGetExpansionType(that) == MFExpansionTypeAlphaBeta);
+  if (isAlphaBeta && world->_iBestTrans[sente] == -1)
+    return 0;
+  // Declare a variable to memorize the nb of ranked transitions
+  int nbRanked = 0;
+  // Insert each transition at its place among the best ones so far
+  for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+    const MFTransition* const trans = MFWorldTransition(world, iTrans);
+    if (isAlphaBeta || MFTransitionIsExpanded(trans)) {
+      float val = MFTransitionGetValue(trans, sente);
+      int iRank = (nbRanked < nb ? nbRanked : nb);
+      while (iRank > 0 && 
+        MFTransitionGetValue(transitions[iRank - 1], sente) < val) {
+        if (iRank < nb)
+          transitions[iRank] = transitions[iRank - 1];
+        --iRank;
+      }
+      if (iRank < nb) {
+        transitions[iRank] = trans;
+        if (nbRanked < nb)
+          ++nbRanked;
+      }
+    }
+  }
+  // The cached best transition is first even if other transitions 
+  // have the same value, the alpha-beta sets it explicitly among 
+  // transitions whose values may be the same upper bound
+  if (nbRanked > 0 && world->_iBestTrans[sente] != -1) {
+    const MFTransition* const bestTrans = 
+      world->_transitions + world->_iBestTrans[sente];
+    for (int iRank = 1; iRank < nbRanked && 
+      transitions[0] != bestTrans; ++iRank) {
+      if (transitions[iRank] == bestTrans) {
+        for (int jRank = iRank; jRank > 0; --jRank)
+          transitions[jRank] = transitions[jRank - 1];
+        transitions[0] = bestTrans;
+      }
+    }
+  }
+  // Return the nb of transitions
+  return nbRanked;
+}
+
 // Get the best MFModelTransition for the 'iActor'-th actor in the 
 // MFWorld 'that'
 // Return NULL if the world has no transition
@@ -849,11 +3685,37 @@ const MFModelTransition* MFWorldBestTransition(
       iActor, MF_NBMAXACTOR);
     PBErrCatch(MiniFrameErr);
   }
+#endif
+  // Return the cached best transition
+  if (that->_iBestTrans[iActor] == -1)
+    return NULL;
+  else
+    return (const MFModelTransition*)(
+      that->_transitions + that->_iBestTrans[iActor]);
+}
+
+// Search the index of the best transition for the 'iActor'-th actor 
+// among the transitions of the MFWorld 'that'
+// Return -1 if the world has no transition
+int MFWorldSearchBestTransition(const MFWorld* const that, 
+  const int iActor) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iActor < 0 || iActor >= MF_NBMAXACTOR) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iActor' is invalid (0<=%d<%d)",
+      iActor, MF_NBMAXACTOR);
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
   // Declare a variable to memorize the highest value among transitions
   float valBestTrans = 0.0;
   // Declare a variable to memorize the transition with highest value
-  const MFTransition* bestTrans = NULL;
+  int iBestTrans = -1;
   // Get the sente
   int sente = MFModelStatusGetSente(MFWorldStatus(that));
   sente = (sente == -1 ? iActor : sente);
@@ -861,43 +3723,270 @@ const MFModelTransition* MFWorldBestTransition(
   for (int iTrans = MFWorldGetNbTrans(that); iTrans--;) {
     // Declare a variable to memorize the transition
     const MFTransition* const trans = MFWorldTransition(that, iTrans);
-#if MF_EXPANSIONTYPE != MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
     // If this transitions has been expanded
+    // The alpha-beta expansion doesn't expand the transitions and sets
+    // explicitly the best transition of the current world
     if (MFTransitionIsExpanded(trans)) {
-#endif
       // Get the value of the transition from the point of view of 
       // the sente
       float val = MFTransitionGetValue(trans, sente);
       // If it's the first considered transition
-      if (bestTrans == NULL) {
+      if (iBestTrans == -1) {
         // Init the best value with the value of this transition
         valBestTrans = val;
         // Init the best transition
-        bestTrans = trans;
+        iBestTrans = iTrans;
       // Else if the value is better
       } else if (valBestTrans < val) {
         // Update the best transition
         valBestTrans = val;
-        bestTrans = trans;
+        iBestTrans = iTrans;
       }
-#if MF_EXPANSIONTYPE != MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
     }
+  }
+  // Return the index of the best transition
+  return iBestTrans;
+}
+
+// Update the end status flag of the MFWorld 'that' after its status 
+// has been modified, and the flags of the worlds reaching it
+void MFWorldUpdateIsEnd(MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
+  // Get the end status flag for the current status
+  bool isEnd = MFModelStatusIsEnd(MFWorldStatus(that));
+  // If the flag has changed
+  if (isEnd != that->_isEnd) {
+    that->_isEnd = isEnd;
+    // Update the nb of transitions reaching an end world of the worlds
+    // reaching this world
+    for (int iSource = MFWorldGetNbSource(that); iSource--;) {
+      MFWorld* fromWorld = 
+        (MFWorld*)MFTransitionFromWorld(MFWorldSource(that, iSource));
+      if (fromWorld != NULL)
+        fromWorld->_nbEndChild += (isEnd ? 1 : -1);
+    }
+  }
+}
+
+// Reset the cached best transitions of the MFWorld 'that' for all 
+// the actors
+void MFWorldResetBestTransition(MFWorld* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  for (int iActor = MF_NBMAXACTOR; iActor--;)
+    that->_iBestTrans[iActor] = 
+      MFWorldSearchBestTransition(that, iActor);
+}
+
+// Update the cached best transitions of the MFWorld 'that' after the
+// values or the result of its 'iTrans'-th transition have changed
+// 'prevValues' are the values of the transition before the change
+void MFWorldUpdateBestTransition(MFWorld* const that, const int iTrans,
+  const float* const prevValues) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iTrans < 0 || iTrans >= that->_nbTransition) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iTrans' is invalid (0<=%d<%d)",
+      iTrans, that->_nbTransition);
+    PBErrCatch(MiniFrameErr);
+  }
+  if (prevValues == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'prevValues' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Declare a variable to memorize the transition
+  const MFTransition* const trans = that->_transitions + iTrans;
+  // Declare a variable to memorize if the transition can be the best
+  // one
+  bool isCandidate = MFTransitionIsExpanded(trans);
+  // Get the sente
+  int sente = MFModelStatusGetSente(MFWorldStatus(that));
+  // Loop on actors
+  for (int iActor = MF_NBMAXACTOR; iActor--;) {
+    int senteActor = (sente == -1 ? iActor : sente);
+    int iBestTrans = that->_iBestTrans[iActor];
+    // If the transition was the best one
+    if (iBestTrans == iTrans) {
+      // If it can't be the best anymore or its value has decreased,
+      // another transition may be the best now
+      if (!isCandidate || 
+        trans->_values[senteActor] < prevValues[senteActor])
+        that->_iBestTrans[iActor] = 
+          MFWorldSearchBestTransition(that, iActor);
+    // Else, if the transition can be the best one
+    } else if (isCandidate) {
+      // If there was no best transition, or the transition is better 
+      // than the best one, it becomes the best one
+      // Between transitions of same value the one with highest index
+      // is the best, as in MFWorldSearchBestTransition
+      if (iBestTrans == -1) {
+        that->_iBestTrans[iActor] = iTrans;
+      } else {
+        float val = trans->_values[senteActor];
+        float valBest = that->_transitions[iBestTrans]._values[senteActor];
+        if (valBest < val || (valBest == val && iBestTrans < iTrans))
+          that->_iBestTrans[iActor] = iTrans;
+      }
+    }
   }
-  // Return the best transition
-  return (const MFModelTransition*)bestTrans;
 }
 
 // Update backward the forecast values for each 
 // transitions leading to the MFWorld 'world' in the MiniFrame 'that'
-// Use a penalty growing with each recursive call to 
-// MFUpdateForecastValues to give priority to fastest convergence to 
-// best solution
-// Avoid infinite loop due to reuse of computed worlds by putting 
-// visited world in the set 'setWorld'
+// Use a penalty growing with the distance to 'world' to give priority
+// to fastest convergence to best solution
+// The worlds on the stack are stamped with the epoch of the update, 
+// which avoids infinite loop due to reuse of computed worlds, and 
+// restamped with the next epoch when popped, so that another path 
+// reaching them later during the update can update them again
 void MFUpdateForecastValues(MiniFrame* const that, 
-  const MFWorld* const world, int delayPenalty, 
-  GSet* const updatedWorld) {
+  const MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  MFPropagateForecastValues(that, world, 0);
+  // Start a new epoch for the next update, after the one of the 
+  // updated worlds
+  that->_backpropEpoch += 2;
+}
+
+// Propagate backward the forecast values of the MFWorld 'world' in the
+// MiniFrame 'that' as MFUpdateForecastValues, with the penalty 
+// starting at 'delayPenalty', during the current epoch of update
+void MFPropagateForecastValues(MiniFrame* const that, 
+  const MFWorld* const world, const int delayPenalty) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the epoch of this update, the worlds stamped with it are on
+  // the stack
+  unsigned long epoch = that->_backpropEpoch;
+  // Declare a variable to memorize the nb of worlds in the stack, 
+  // the penalty of a world grows with its depth in the stack
+  int nbFrame = 0;
+  // Declare a variable to memorize the next world to push on the stack
+  MFWorld* nextWorld = (MFWorld*)world;
+  // Loop until the stack is empty
+  do {
+    // If there is a world to push on the stack
+    if (nextWorld != NULL) {
+      // If the world has ancestor and is not already on the stack
+      if (MFWorldGetNbSource(nextWorld) > 0 && 
+        nextWorld->_visitEpoch != epoch) {
+        // Grow the stack if necessary
+        if (nbFrame == that->_nbAllocBackprop)
+          MFGrowBackpropStack(that);
+        // Stamp the world
+        nextWorld->_visitEpoch = epoch;
+        // Get the sente of the world
+        int sente = MFModelStatusGetSente(MFWorldStatus(nextWorld));
+        // Search the best transition of the world
+        const MFTransition* bestTrans = 
+          (const MFTransition*)MFWorldBestTransition(nextWorld, sente);
+        // Declare a pointer toward the forecast values
+        const float* forecastValues = NULL;
+        if (bestTrans == NULL)
+          forecastValues = nextWorld->_values;
+        else
+          forecastValues = bestTrans->_values;
+        // Push the world and its updated forecast values
+        MFBackpropFrame* frame = that->_backpropStack + nbFrame;
+        frame->_world = nextWorld;
+        frame->_iSource = 0;
+        for (int iActor = MF_NBMAXACTOR; iActor--;)
+          frame->_values[iActor] = 
+            forecastValues[iActor] - 
+            (float)(delayPenalty + nbFrame) * PBMATH_EPSILON;
+        ++nbFrame;
+      }
+      nextWorld = NULL;
+    // Else, continue with the world on top of the stack
+    } else {
+      MFBackpropFrame* frame = that->_backpropStack + nbFrame - 1;
+      // If there are transitions to this world left to update
+      if (frame->_iSource < MFWorldGetNbSource(frame->_world)) {
+        // Get the transition
+        MFTransition* const trans = (MFTransition*)MFWorldSource(
+          frame->_world, frame->_iSource);
+        ++(frame->_iSource);
+        // Update the values of the transition, if they have been 
+        // modified update the source of the transition
+        if (MFTransitionUpdateValues(trans, frame->_values)) {
+          nextWorld = (MFWorld*)MFTransitionFromWorld(trans);
+          MFCheckPV(that, nextWorld);
+        }
+      // Else, all the transitions to this world have been updated
+      } else {
+        // Pop the world from the stack, and restamp it as updated, 
+        // another path reaching it later during this update must 
+        // update it again for its new forecast values to reach its 
+        // ancestors
+        --nbFrame;
+        that->_backpropStack[nbFrame]._world->_visitEpoch = epoch + 1;
+      }
+    }
+  } while (nbFrame > 0);
+}
+
+// Double the size of the stack used by MFUpdateForecastValues in the
+// MiniFrame 'that'
+void MFGrowBackpropStack(MiniFrame* const that) {
+  // Declare a variable to memorize the new size of the stack
+  int nbAlloc = (that->_nbAllocBackprop == 0 ? 
+    MF_NBINITBACKPROPSTACK : 2 * that->_nbAllocBackprop);
+  // Allocate the new array
+  MFBackpropFrame* stack = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFBackpropFrame) * nbAlloc);
+  // Copy the current frames and replace the current array
+  if (that->_backpropStack != NULL) {
+    memcpy(stack, that->_backpropStack, 
+      sizeof(MFBackpropFrame) * that->_nbAllocBackprop);
+    free(that->_backpropStack);
+  }
+  that->_backpropStack = stack;
+  that->_nbAllocBackprop = nbAlloc;
+}
+
+// Mark the MFWorld 'world' of the MiniFrame 'that' as having forecast
+// values to be updated backward by the next call to 
+// MFUpdateDirtyForecastValues
+void MFMarkWorldDirty(MiniFrame* const that, MFWorld* const world) {
 #if BUILDMODE == 0
   if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
@@ -909,62 +3998,154 @@ void MFUpdateForecastValues(MiniFrame* const that,
     sprintf(MiniFrameErr->_msg, "'world' is null");
     PBErrCatch(MiniFrameErr);
   }
-#if MF_REUSEWORLD == true
-  if (updatedWorld == NULL) {
+#endif
+  // If the world has no ancestor or is already marked during this 
+  // epoch there is nothing to do
+  if (MFWorldGetNbSource(world) == 0 || 
+    world->_visitEpoch == that->_backpropEpoch)
+    return;
+  world->_visitEpoch = that->_backpropEpoch;
+  // Grow the heap if necessary
+  if (that->_nbDirtyWorld == that->_nbAllocDirty) {
+    int nbAlloc = (that->_nbAllocDirty == 0 ? 
+      MF_NBINITDIRTYWORLD : 2 * that->_nbAllocDirty);
+    MFWorld** worlds = PBErrMalloc(MiniFrameErr, 
+      sizeof(MFWorld*) * nbAlloc);
+    if (that->_dirtyWorlds != NULL) {
+      memcpy(worlds, that->_dirtyWorlds, 
+        sizeof(MFWorld*) * that->_nbDirtyWorld);
+      free(that->_dirtyWorlds);
+    }
+    that->_dirtyWorlds = worlds;
+    that->_nbAllocDirty = nbAlloc;
+  }
+  // Add the world at the end of the heap and move it up until its 
+  // parent is not less deep
+  int iElem = that->_nbDirtyWorld;
+  ++(that->_nbDirtyWorld);
+  while (iElem > 0 && 
+    that->_dirtyWorlds[(iElem - 1) / 2]->_depth < world->_depth) {
+    that->_dirtyWorlds[iElem] = that->_dirtyWorlds[(iElem - 1) / 2];
+    iElem = (iElem - 1) / 2;
+  }
+  that->_dirtyWorlds[iElem] = world;
+}
+
+// Pop the deepest world among the worlds marked by MFMarkWorldDirty 
+// in the MiniFrame 'that'
+// The depth of a reused world is the one at its creation, it may be 
+// stale and the order then differs from the distance to the expanded
+// worlds, MFUpdateDirtyForecastValues covers it by propagating again
+// the worlds already updated
+// Return the world
+MFWorld* MFPopDirtyWorld(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (that->_nbDirtyWorld == 0) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "no marked world");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the deepest world
+  MFWorld* const world = that->_dirtyWorlds[0];
+  // Move the last world of the heap down from the root until its 
+  // children are not deeper
+  --(that->_nbDirtyWorld);
+  MFWorld* const last = that->_dirtyWorlds[that->_nbDirtyWorld];
+  int iElem = 0;
+  int iChild = 1;
+  while (iChild < that->_nbDirtyWorld) {
+    if (iChild + 1 < that->_nbDirtyWorld && 
+      that->_dirtyWorlds[iChild]->_depth < 
+      that->_dirtyWorlds[iChild + 1]->_depth)
+      ++iChild;
+    if (that->_dirtyWorlds[iChild]->_depth <= last->_depth)
+      break;
+    that->_dirtyWorlds[iElem] = that->_dirtyWorlds[iChild];
+    iElem = iChild;
+    iChild = 2 * iElem + 1;
+  }
+  that->_dirtyWorlds[iElem] = last;
+  // Return the world
+  return world;
+}
+
+// Update backward the forecast values for each transitions leading 
+// to the worlds marked by MFMarkWorldDirty in the MiniFrame 'that'
+// The worlds are updated in reverse order of depth, with a penalty 
+// growing with the distance to the deepest marked world
+// A world already updated whose forecast values change again, as the
+// reused worlds may be deeper than the worlds reaching them, is 
+// propagated backward by MFPropagateForecastValues
+void MFUpdateDirtyForecastValues(MiniFrame* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
     MiniFrameErr->_type = PBErrTypeNullPointer;
-    sprintf(MiniFrameErr->_msg, "'updatedWorld' is null");
+    sprintf(MiniFrameErr->_msg, "'that' is null");
     PBErrCatch(MiniFrameErr);
   }
 #endif
-#endif
-  // If the world has not been updated yet and has ancestor
-  if (GSetNbElem(MFWorldSources(world)) > 0
-#if MF_REUSEWORLD == true
-    && GSetFirstElem(updatedWorld, world) == NULL
-#endif
-    ) {
-#if MF_REUSEWORLD == true
-    GSetAppend(updatedWorld, (void*)world);
-#endif
+  // If there is no marked world there is nothing to do
+  if (that->_nbDirtyWorld == 0)
+    return;
+  // Declare a variable to memorize the depth of the deepest world, 
+  // from which the penalty is calculated
+  int maxDepth = that->_dirtyWorlds[0]->_depth;
+  // Get the epoch of this update, the worlds stamped with it are 
+  // marked, the ones stamped with the next one have been updated
+  unsigned long epoch = that->_backpropEpoch;
+  // Loop until there is no marked world
+  do {
+    // Get the deepest marked world, and stamp it as updated
+    MFWorld* const world = MFPopDirtyWorld(that);
+    world->_visitEpoch = epoch + 1;
     // Get the sente of the world
     int sente = MFModelStatusGetSente(MFWorldStatus(world));
     // Search the best transition of the world
-    MFTransition* bestTrans = 
-      (MFTransition*)MFWorldBestTransition(world, sente);
-    // Declare a variable to memorize the updated forecast values
-    float updatedForecastValues[MF_NBMAXACTOR] = {0.0};
+    const MFTransition* bestTrans = 
+      (const MFTransition*)MFWorldBestTransition(world, sente);
     // Declare a pointer toward the forecast values
-    float* forecastValues = NULL;
+    const float* forecastValues = NULL;
     if (bestTrans == NULL)
-      forecastValues = ((MFWorld*)world)->_values;
+      forecastValues = world->_values;
     else
       forecastValues = bestTrans->_values;
-    // Calculate the updated forecast values
+    // Calculate the updated forecast values, the reused worlds may be
+    // deeper than the worlds reaching them
+    float delayPenalty = (float)MAX(0, maxDepth - world->_depth);
+    float updatedForecastValues[MF_NBMAXACTOR] = {0.0};
     for (int iActor = MF_NBMAXACTOR; iActor--;)
       updatedForecastValues[iActor] = 
-        forecastValues[iActor] - (float)delayPenalty * PBMATH_EPSILON;
+        forecastValues[iActor] - delayPenalty * PBMATH_EPSILON;
     // For each transition to the world
-    GSetIterForward iter = 
-      GSetIterForwardCreateStatic(MFWorldSources(world));
-    do {
+    for (int iSource = 0; iSource < MFWorldGetNbSource(world); 
+      ++iSource) {
       // Get the transition
-      MFTransition* const trans = GSetIterGet(&iter);
-      // Update the values of the transition
-      bool updated = 
-        MFTransitionUpdateValues(trans, updatedForecastValues);
-      // If the values has been modified
-      if (updated) {
-        // Update recursively the source of the transition
-        MFUpdateForecastValues(that, MFTransitionFromWorld(trans),
-          delayPenalty + 1, updatedWorld);
+      MFTransition* const trans = 
+        (MFTransition*)MFWorldSource(world, iSource);
+      // Update the values of the transition, if they have been 
+      // modified mark the source of the transition, or propagate its
+      // new forecast values if it has already been updated
+      if (MFTransitionUpdateValues(trans, updatedForecastValues)) {
+        MFWorld* const fromWorld = 
+          (MFWorld*)MFTransitionFromWorld(trans);
+        MFCheckPV(that, fromWorld);
+        if (fromWorld->_visitEpoch == epoch + 1)
+          MFPropagateForecastValues(that, fromWorld, 
+            MAX(0, maxDepth - fromWorld->_depth));
+        else
+          MFMarkWorldDirty(that, fromWorld);
       }
-    } while (GSetIterStep(&iter));
-#if MF_REUSEWORLD == true
-    // Remove the world for the set of visited world to allow
-    // another path to reupdate it later
-    GSetRemoveFirst(updatedWorld, (void*)world);
-#endif
-  }
+    }
+  } while (that->_nbDirtyWorld > 0);
+  // Start a new epoch for the next update, after the one of the 
+  // updated worlds
+  that->_backpropEpoch += 2;
 }
 
 // Update the values of the MFTransition 'that' with 'val'
@@ -984,15 +4165,26 @@ bool MFTransitionUpdateValues(MFTransition* const that, const float* val) {
 #endif
   // Declare a variable to memorize the returned flag
   bool updated = false;
+  // Declare a variable to memorize the values before update
+  float prevValues[MF_NBMAXACTOR];
   // Update values
   float* const thatValues = that->_values;
   for (int iActor = MF_NBMAXACTOR; iActor--;) {
+    prevValues[iActor] = thatValues[iActor];
     // If the new value is different from the current one
     if (!ISEQUALF(thatValues[iActor], val[iActor])) {
       thatValues[iActor] = val[iActor];
       updated = true;
     }
   }
+  // If the values have been updated, update the best transitions of 
+  // the world of this transition
+  if (updated) {
+    MFWorld* const fromWorld = (MFWorld*)MFTransitionFromWorld(that);
+    if (fromWorld != NULL)
+      MFWorldUpdateBestTransition(fromWorld, 
+        that - fromWorld->_transitions, prevValues);
+  }
   // Return the flag
   return updated;
 }
@@ -1108,7 +4300,40 @@ void MFSetCurWorld(MiniFrame* const that,
     PBErrCatch(MiniFrameErr);
   }
 #endif
-#if MF_EXPANSIONTYPE != MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
+  // Stop the pondering, if any, before modifying the tree
+  MFStopPondering(that);
+  // The principal variation starts from the current world
+  that->_isPVValid = false;
+  // Dispatch to the function of the current expansion type
+  switch (that->_expansionType) {
+    case MFExpansionTypeMCTS:
+      MFSetCurWorldMCTS(that, status);
+      break;
+    case MFExpansionTypeAlphaBeta:
+      MFSetCurWorldAlphaBeta(that, status);
+      break;
+    default:
+      MFSetCurWorldGraph(that, status);
+      break;
+  }
+}
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandGraph() to the world with status 'status'
+void MFSetCurWorldGraph(MiniFrame* const that,
+  const MFModelStatus* const status) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (status == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'status' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
   // Declare a flag to memorize if we have found the world
   bool flagFound = false;
   // If there are computed worlds
@@ -1127,17 +4352,19 @@ void MFSetCurWorld(MiniFrame* const that,
         // MFModelStatus struct, in case MFModelStatusIsSame refers only
         // to a subset of properties of the MFModelStatus
         memcpy(world, status, sizeof(MFModelStatus));
+        MFWorldUpdateIsEnd(world);
         // Update the curWorld in MiniFrame
         that->_curWorld = world;
         flagFound = true;
       // Else if this world is disposable
       } else if (world != MFCurWorld(that) && 
-        (GSetNbElem(MFWorldSources(world)) == 0 || 
+        (MFWorldGetNbSource(world) == 0 || 
         MFModelStatusIsDisposable(MFWorldStatus(world), 
         MFWorldStatus(MFCurWorld(that))))) {
         // Remove it from the set of computed worlds
         moved = GSetIterRemoveElem(&iter);
         // Free this world
+        MFRemoveWorldFromHash(that, world);
         MFWorldFree(&world);
       }
     } while (moved || GSetIterStep(&iter));
@@ -1147,26 +4374,25 @@ void MFSetCurWorld(MiniFrame* const that,
     // If there are worlds to expand
     if (MFGetNbWorldsToExpand(that) > 0) {
       // Loop on worlds to expand
-      GSetIterForward iter = 
-        GSetIterForwardCreateStatic(MFWorldsToExpand(that));
-      do {
-        MFWorld* world = GSetIterGet(&iter);
+      for (int iWorld = 0; !flagFound && 
+        iWorld < MFGetNbWorldsToExpand(that); ++iWorld) {
+        MFWorld* world = MFFrontierGet(MFWorldsToExpand(that), iWorld);
         // If this is the current world
         if (MFModelStatusIsSame(MFWorldStatus(world), status)) {
           // Ensure that the status is exactly the same by copying the 
           // MFModelStatus struct, in case MFModelStatusIsSame refers only
           // to a subset of properties of the MFModelStatus
           memcpy(world, status, sizeof(MFModelStatus));
+          MFWorldUpdateIsEnd(world);
           // Update the curWorld in MiniFrame
           that->_curWorld = world;
           flagFound = true;
-          // Put the current world at the end of the worlds to expand
-          // to be sure it will be the first expanded
-          bool moved = GSetIterForwardRemoveElem(&iter);
-          (void)moved;
-          GSetAppend((GSet*)MFWorldsToExpand(that), world);
+          // Move the current world in the worlds to expand to be sure 
+          // it will be the first expanded
+          MFFrontierRemove(&(that->_worldsToExpand), iWorld);
+          MFFrontierPushNext(&(that->_worldsToExpand), world);
         }
-      } while (!flagFound && GSetIterStep(&iter));
+      }
     }
   }
   // If we haven't found the searched status
@@ -1175,7 +4401,8 @@ void MFSetCurWorld(MiniFrame* const that,
     ++(that->_nbWorldNotFound);
 #endif
     // Create a new MFWorld with the current status
-    MFWorld* world = MFWorldCreate(status);
+    MFWorld* world = 
+      MFWorldCreateFromPool(&(that->_worldPool), status);
     // Set the depth of the new world to the depth of the current world
 #if MF_SIMULTANEOUS_PLAY
     world->_depth = that->_curWorld->_depth + 1;
@@ -1189,20 +4416,196 @@ void MFSetCurWorld(MiniFrame* const that,
     // Flush all the worlds
     while(MFGetNbComputedWorlds(that) > 0) {
       world = GSetPop((GSet*)MFWorldsComputed(that));
+      MFRemoveWorldFromHash(that, world);
       MFWorldFree(&world);
     }
     while(MFGetNbWorldsToExpand(that) > 0) {
-      world = GSetPop((GSet*)MFWorldsToExpand(that));
+      world = MFFrontierPop(&(that->_worldsToExpand));
+      MFRemoveWorldFromHash(that, world);
       MFWorldFree(&world);
     }
 #endif
     // Add it to the worlds to expand
-    GSetAppend((GSet*)MFWorldsToExpand(that), that->_curWorld);
+    MFFrontierPushNext(&(that->_worldsToExpand), that->_curWorld);
+    MFAddWorldToHash(that, that->_curWorld);
+  }
+}
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandMCTS() to the world with status 'status'
+void MFSetCurWorldMCTS(MiniFrame* const that,
+  const MFModelStatus* const status) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (status == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'status' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // Get the depth of a new root of the tree, which follows the one of 
+  // the current world, before it may be freed
+#if MF_SIMULTANEOUS_PLAY
+  int depth = that->_curWorld->_depth + 1;
+#else
+  int depth = that->_curWorld->_depth + 
+    MFModelStatusGetNbActor(status);
+#endif
+  // Search the world in the tree of the MCTS, the shallowest first,
+  // using the frontier of worlds to expand as a queue
+  MFWorld* curWorld = NULL;
+  MFFrontierPushLast(&(that->_worldsToExpand), that->_curWorld);
+  while (MFGetNbWorldsToExpand(that) > 0) {
+    MFWorld* world = MFFrontierPop(&(that->_worldsToExpand));
+    if (curWorld == NULL) {
+      if (MFModelStatusIsSame(MFWorldStatus(world), status)) {
+        curWorld = world;
+      } else {
+        for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+          MFWorld* toWorld = (MFWorld*)MFTransitionToWorld(
+            MFWorldTransition(world, iTrans));
+          if (toWorld != NULL)
+            MFFrontierPushLast(&(that->_worldsToExpand), toWorld);
+        }
+      }
+    }
+  }
+  // If we have found the world, stamp the worlds of its subtree to 
+  // keep them and their statistics
+  if (curWorld != NULL) {
+    // Ensure that the status is exactly the same by copying the 
+    // MFModelStatus struct, in case MFModelStatusIsSame refers only
+    // to a subset of properties of the MFModelStatus
+    memcpy(curWorld, status, sizeof(MFModelStatus));
+    MFWorldUpdateIsEnd(curWorld);
+    MFFrontierPushLast(&(that->_worldsToExpand), curWorld);
+    while (MFGetNbWorldsToExpand(that) > 0) {
+      MFWorld* world = MFFrontierPop(&(that->_worldsToExpand));
+      world->_keepEpoch = that->_keepEpoch;
+      for (int iTrans = MFWorldGetNbTrans(world); iTrans--;) {
+        MFWorld* toWorld = (MFWorld*)MFTransitionToWorld(
+          MFWorldTransition(world, iTrans));
+        if (toWorld != NULL)
+          MFFrontierPushLast(&(that->_worldsToExpand), toWorld);
+      }
+    }
+  }
+  // Free the worlds out of the subtree, they are all freed so there 
+  // is no need to update the links between them
+  if (MFGetNbComputedWorlds(that) > 0) {
+    bool moved = false;
+    GSetIterForward iter = 
+      GSetIterForwardCreateStatic(MFWorldsComputed(that));
+    do {
+      moved = false;
+      MFWorld* world = GSetIterGet(&iter);
+      if (curWorld == NULL || 
+        world->_keepEpoch != that->_keepEpoch) {
+        moved = GSetIterRemoveElem(&iter);
+        MFWorldFreeProperties(world);
+        if (world->_pool != NULL)
+          MFWorldPoolRelease(world->_pool, world);
+        else
+          free(world);
+      }
+    } while (moved || GSetIterStep(&iter));
+  }
+  ++(that->_keepEpoch);
+  // If we have found the world, it becomes the root of the tree
+  if (curWorld != NULL) {
+    while (MFWorldGetNbSource(curWorld) > 0)
+      MFWorldPopSource(curWorld);
+  // Else, create a new tree
+  } else {
+#if MF_USETELEMETRY
+    ++(that->_nbWorldNotFound);
+#endif
+    curWorld = MFWorldCreateFromPool(&(that->_worldPool), status);
+    curWorld->_depth = depth;
+    GSetAppend(&(that->_worldsComputed), curWorld);
+  }
+  that->_curWorld = curWorld;
+}
+
+// Set the current world of the MiniFrame 'that' expanded by 
+// MFExpandAlphaBeta() to the world with status 'status'
+void MFSetCurWorldAlphaBeta(MiniFrame* const that,
+  const MFModelStatus* const status) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (status == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'status' is null");
+    PBErrCatch(MiniFrameErr);
   }
+#endif
+  // Replace the current world with a new one for the status, whose 
+  // depth follows the one of the current world
+#if MF_SIMULTANEOUS_PLAY
+  int depth = that->_curWorld->_depth + 1;
 #else
-  // Update the current world with the status
-  *(that->_curWorld) = MFWorldCreateStatic(status);
+  int depth = that->_curWorld->_depth + 
+    MFModelStatusGetNbActor(status);
+#endif
+  MFWorldFree(&(that->_curWorld));
+  that->_curWorld = MFWorldCreateFromPool(&(that->_worldPool), status);
+  that->_curWorld->_depth = depth;
+}
+
+// Set the type of expansion for the MiniFrame 'that' to 'type'
+// The type can be changed between two steps of a game: if it differs
+// from the current one, the worlds computed so far are discarded and
+// the expansion restarts from the current world
+// Stop the pondering if the MiniFrame is pondering
+void MFSetExpansionType(MiniFrame* const that, 
+  const MFExpansionType type) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (type < MFExpansionTypeValue || type > MFExpansionTypeAlphaBeta) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'type' is invalid (%d)", type);
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
+  // Stop the pondering, if any, before modifying the tree
+  MFStopPondering(that);
+  if (that->_expansionType == type)
+    return;
+  // Create the current world of the new expansion with the status of
+  // the current one, the other worlds are discarded as their frontier
+  // and statistics are specific to the previous expansion type
+  MFWorld* curWorld = MFWorldCreateFromPool(&(that->_worldPool), 
+    MFWorldStatus(MFCurWorld(that)));
+  curWorld->_depth = MFCurWorld(that)->_depth;
+  MFFreeWorlds(that);
+  that->_isPVValid = false;
+  // The costs of the steps of the previous expansion type don't 
+  // predict the ones of the new type
+  MFTimeManagerResetStepCost(&(that->_timeManager));
+  // Switch to the new expansion type and its frontier
+  MFFrontierFreeStatic(&(that->_worldsToExpand));
+  that->_expansionType = type;
+  that->_worldsToExpand = 
+    MFFrontierCreateStatic(type == MFExpansionTypeValue);
+  that->_expByDepthAppendPos = 0;
+  that->_curWorld = curWorld;
+  // The tree of the MCTS is memorized in the computed worlds
+  if (type == MFExpansionTypeMCTS)
+    GSetAppend(&(that->_worldsComputed), curWorld);
+  else
+    MFAddWorldToExpand(that, curWorld);
 }
 
 // Remove the MFTransition 'source' from the sources of the 
@@ -1221,23 +4624,64 @@ void MFWorldRemoveSource(MFWorld* const that,
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  // If the world has sources
-  if (GSetNbElem(MFWorldSources(that)) > 0) {
-    bool removed = false;
-    // Loop on transitions
-    GSetIterForward iter = 
-      GSetIterForwardCreateStatic(MFWorldSources(that));
-    do {
-      removed = false;
-      MFTransition* trans = GSetIterGet(&iter);
-      // If it's the transition to be removed
-      if (trans == source) {
-        removed = GSetIterRemoveElem(&iter);
-      }
-    } while (removed || GSetIterStep(&iter));
+  // Search the transition to be removed
+  int iSource = 0;
+  while (iSource < MFWorldGetNbSource(that) &&
+    MFWorldSource(that, iSource) != source)
+    ++iSource;
+  // If the transition has been found
+  if (iSource < MFWorldGetNbSource(that)) {
+    // Shift the following transitions to keep the order of sources
+    for (; iSource < MFWorldGetNbSource(that) - 1; ++iSource) {
+      MFTransition* next = 
+        (MFTransition*)MFWorldSource(that, iSource + 1);
+      if (iSource < MF_NBINLINESOURCE)
+        that->_sources[iSource] = next;
+      else
+        that->_extraSources[iSource - MF_NBINLINESOURCE] = next;
+    }
+    --(that->_nbSource);
   }
 }
 
+// Add the MFTransition 'source' to the sources of the MFWorld 'that'
+void MFWorldAddSource(MFWorld* const that, MFTransition* const source) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (source == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'source' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // If there is room inside the world
+  if (that->_nbSource < MF_NBINLINESOURCE) {
+    that->_sources[that->_nbSource] = source;
+  // Else, the source goes in the allocated array
+  } else {
+    int iExtra = that->_nbSource - MF_NBINLINESOURCE;
+    // If the allocated array is full, double its size
+    if (iExtra >= that->_nbExtraSourceAlloc) {
+      int size = (that->_nbExtraSourceAlloc == 0 ? 
+        MF_NBINLINESOURCE : 2 * that->_nbExtraSourceAlloc);
+      MFTransition** extra = PBErrMalloc(MiniFrameErr, 
+        sizeof(MFTransition*) * size);
+      if (that->_extraSources != NULL) {
+        memcpy(extra, that->_extraSources, 
+          sizeof(MFTransition*) * that->_nbExtraSourceAlloc);
+        free(that->_extraSources);
+      }
+      that->_extraSources = extra;
+      that->_nbExtraSourceAlloc = size;
+    }
+    that->_extraSources[iExtra] = source;
+  }
+  ++(that->_nbSource);
+}
 
 // Pop a MFTransition from the sources of the MFWorld 'that'
 #if BUILDMODE != 0
@@ -1251,7 +4695,12 @@ MFTransition* MFWorldPopSource(MFWorld* const that) {
     PBErrCatch(MiniFrameErr);
   }
 #endif
-  return GSetPop(&(that->_sources));
+  // Pop the last source
+  --(that->_nbSource);
+  if (that->_nbSource < MF_NBINLINESOURCE)
+    return that->_sources[that->_nbSource];
+  else
+    return that->_extraSources[that->_nbSource - MF_NBINLINESOURCE];
 }
 
 // Print the best forecasted story from the MFWorld 'that' for the 
@@ -1276,55 +4725,240 @@ void MFWorldPrintBestStoryln(const MFWorld* const that,
     PBErrCatch(MiniFrameErr);
   }
 #endif
+  // Search the length of the loop in the story, if any, with Brent's 
+  // algorithm: the hare moves one world at a time and the tortoise 
+  // jumps to the hare each time the distance between them reaches a 
+  // power of 2, they meet if the story loops
+  int lenLoop = 1;
+  int power = 1;
+  const MFWorld* tortoise = that;
+  const MFTransition* trans = MFWorldBestStoryTrans(that, iActor);
+  const MFWorld* hare = (trans != NULL ? MFTransitionToWorld(trans) : NULL);
+  while (hare != NULL && hare != tortoise) {
+    if (power == lenLoop) {
+      tortoise = hare;
+      power *= 2;
+      lenLoop = 0;
+    }
+    trans = MFWorldBestStoryTrans(hare, iActor);
+    hare = (trans != NULL ? MFTransitionToWorld(trans) : NULL);
+    ++lenLoop;
+  }
+  // Declare a variable to memorize the nb of worlds of the story 
+  // before reaching a world already visited, -1 if the story doesn't
+  // loop
+  int nbWorldStory = -1;
+  // If the story loops, search the first world of the loop by moving 
+  // two worlds 'lenLoop' worlds apart until they meet
+  if (hare != NULL) {
+    tortoise = that;
+    hare = that;
+    for (int iWorld = lenLoop; iWorld--;)
+      hare = MFTransitionToWorld(MFWorldBestStoryTrans(hare, iActor));
+    nbWorldStory = lenLoop;
+    while (tortoise != hare) {
+      tortoise = 
+        MFTransitionToWorld(MFWorldBestStoryTrans(tortoise, iActor));
+      hare = MFTransitionToWorld(MFWorldBestStoryTrans(hare, iActor));
+      ++nbWorldStory;
+    }
+  }
   // Declare a variable to memorize the current displayed world
   const MFWorld* curWorld = that;
-  // Declare a GSet to manage infinite loop
-  GSet setWorld = GSetCreateStatic();
   // Loop until the end of the forecast
-  while (curWorld != NULL) { 
-    // Display the current world
-    //MFWorldPrint(curWorld, stream);
-    //fprintf(stream, "\n");
-    MFWorldTransPrintln(curWorld, stream);
-    // Add the world to the set of visited worlds
-    GSetAppend(&setWorld, (void*)curWorld);
-    // If we are not at an end status
-    if (!MFModelStatusIsEnd(MFWorldStatus(curWorld))) {
-      // Get the sente for the current world
-      int sente = MFModelStatusGetSente(MFWorldStatus(curWorld));
-      // If it's a simultaneous game
-      if (sente == -1)
-        sente = iActor;
-      // Get the best transition from this world
-      const MFModelTransition* bestTrans = 
-        MFWorldBestTransition(curWorld, sente);
-      // If there is no transition
-      if (bestTrans == NULL) {
-        // Stop the story here
+  for (int iWorld = 0; curWorld != NULL; ++iWorld) { 
+    // If we reach a world already visited
+    if (iWorld == nbWorldStory) {
+      MFWorldPrint(curWorld, stream);
+      fprintf(stream, "\n");
+      fprintf(stream, "--> infinite loop in best story, quit\n");
+      curWorld = NULL;
+    } else {
+      // Display the current world
+      MFWorldTransPrintln(curWorld, stream);
+      // If we are at an end status
+      if (MFWorldIsEnd(curWorld)) {
+        fprintf(stream, "--> reached a end status\n");
         curWorld = NULL;
-      // Else, there is a best transition
-      } else {
+      // Else, if there is a best transition
+      } else if ((trans = 
+        MFWorldBestStoryTrans(curWorld, iActor)) != NULL) {
         // Print the best transition
         fprintf(stream, "--> ");
-        MFTransitionPrint((const MFTransition*)bestTrans, stream);
+        MFTransitionPrint(trans, stream);
         fprintf(stream, "\n");
         // Move to the world resulting from the best transition
-        curWorld = MFTransitionToWorld((const MFTransition*)bestTrans);
+        curWorld = MFTransitionToWorld(trans);
+      // Else, there is no transition, stop the story here
+      } else {
+        curWorld = NULL;
       }
-    } else {
-      fprintf(stream, "--> reached a end status\n");
-      curWorld = NULL;
-    }
-    // If we reach a world already visited
-    if (curWorld != NULL && GSetFirstElem(&setWorld, curWorld) != NULL) {
-      MFWorldPrint(curWorld, stream);
-      fprintf(stream, "\n");
-      fprintf(stream, "--> infinite loop in best story, quit\n");
-      curWorld = NULL;
     }
   }
-  // Free memory
-  GSetFlush(&setWorld);
+}
+
+// Get the transition following the MFWorld 'that' in its best story 
+// for the actor 'iActor'
+// Return NULL if the world is an end world or has no best transition
+const MFTransition* MFWorldBestStoryTrans(const MFWorld* const that, 
+  const int iActor) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (MFWorldIsEnd(that))
+    return NULL;
+  // Get the sente for the world, if it's a simultaneous game use the
+  // actor 'iActor'
+  int sente = MFModelStatusGetSente(MFWorldStatus(that));
+  if (sente == -1)
+    sente = iActor;
+  return (const MFTransition*)MFWorldBestTransition(that, sente);
+}
+
+// Get the principal variation from the current world of the 
+// MiniFrame 'that', i.e. the sequence of best transitions for the 
+// sente of each world, or for the 'iActor'-th actor if the world has 
+// no sente, until an end world, a world without transition or a world
+// already in the sequence
+// The nb of transitions is returned in 'length'
+// The principal variation is maintained while expanding and rebuilt 
+// only if a best transition along it has changed since the last call
+// The returned array belongs to the MiniFrame and is valid until the 
+// next call to a function modifying the MiniFrame
+const MFTransition* const* MFGetPV(MiniFrame* const that, 
+  const int iActor, int* const length) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (iActor < 0 || iActor >= MF_NBMAXACTOR) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, "'iActor' is invalid (0<=%d<%d)",
+      iActor, MF_NBMAXACTOR);
+    PBErrCatch(MiniFrameErr);
+  }
+  if (length == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'length' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // If the principal variation is not up to date, rebuild it from the
+  // current world
+  if (!that->_isPVValid || that->_pvActor != iActor) {
+    that->_pvActor = iActor;
+    that->_pvLength = 0;
+    MFWorld* world = (MFWorld*)MFCurWorld(that);
+    world->_iPV = 0;
+    // Declare a variable to memorize the transition from the last world
+    // of the principal variation
+    const MFTransition* trans = NULL;
+    do {
+      // Grow the arrays if necessary, there is always room for the 
+      // world reached by the last transition
+      if (that->_pvLength + 2 > that->_nbAllocPV) {
+        int nbAlloc = (that->_nbAllocPV == 0 ? 
+          MF_NBINITPV : 2 * that->_nbAllocPV);
+        const MFTransition** pv = PBErrMalloc(MiniFrameErr, 
+          sizeof(MFTransition*) * nbAlloc);
+        MFWorld** pvWorlds = PBErrMalloc(MiniFrameErr, 
+          sizeof(MFWorld*) * nbAlloc);
+        if (that->_pv != NULL) {
+          memcpy(pv, that->_pv, 
+            sizeof(MFTransition*) * that->_pvLength);
+          memcpy(pvWorlds, that->_pvWorlds, 
+            sizeof(MFWorld*) * (that->_pvLength + 1));
+          free(that->_pv);
+          free(that->_pvWorlds);
+        }
+        that->_pv = pv;
+        that->_pvWorlds = pvWorlds;
+        that->_nbAllocPV = nbAlloc;
+      }
+      // Add the world to the principal variation
+      that->_pvWorlds[that->_pvLength] = world;
+      // Get the best transition from the world
+      trans = MFWorldBestStoryTrans(world, iActor);
+      if (trans != NULL) {
+        that->_pv[that->_pvLength] = trans;
+        ++(that->_pvLength);
+        world = (MFWorld*)MFTransitionToWorld(trans);
+        // Stop if the transition has not been computed or reaches a 
+        // world already in the principal variation, else stamp the 
+        // world with its index
+        // The index of the world is checked against the part of the
+        // principal variation already rebuilt
+        if (world == NULL || (world->_iPV >= 0 && 
+          world->_iPV < that->_pvLength && 
+          that->_pvWorlds[world->_iPV] == world))
+          trans = NULL;
+        else
+          world->_iPV = that->_pvLength;
+      }
+    } while (trans != NULL);
+    that->_pvWorlds[that->_pvLength] = world;
+    that->_isPVValid = true;
+  }
+  // Return the principal variation
+  *length = that->_pvLength;
+  return that->_pv;
+}
+
+// Return true if the MFWorld 'world' is in the principal variation 
+// of the MiniFrame 'that', else false
+bool MFWorldIsOnPV(const MiniFrame* const that, 
+  const MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  // The index memorized in the world may be outdated, it is valid only
+  // if the world is at this index
+  return world->_iPV >= 0 && world->_iPV <= that->_pvLength && 
+    that->_pvWorlds[world->_iPV] == world;
+}
+
+// Invalidate the principal variation of the MiniFrame 'that' if the 
+// MFWorld 'world' is in it and its best transition doesn't match 
+// anymore the principal variation
+void MFCheckPV(MiniFrame* const that, const MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+#endif
+  if (!that->_isPVValid || !MFWorldIsOnPV(that, world))
+    return;
+  // The last world of the principal variation has no transition in 
+  // it, the principal variation must be extended if it has now one
+  const MFTransition* trans = NULL;
+  if (world->_iPV < that->_pvLength)
+    trans = that->_pv[world->_iPV];
+  if (MFWorldBestStoryTrans(world, that->_pvActor) != trans || 
+    (trans != NULL && 
+    MFTransitionToWorld(trans) != that->_pvWorlds[world->_iPV + 1]))
+    that->_isPVValid = false;
 }
 
 // Set the values of the MFWorld 'that' to 'values'
@@ -1387,21 +5021,142 @@ void MFAddWorldToExpand(MiniFrame* const that, \
     PBErrCatch(MiniFrameErr);
   }
 #endif
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYVALUE
-  GSetAddSort(&(that->_worldsToExpand), (MFWorld*)world, 
-    MFWorldGetValue(world, 
-    MFModelStatusGetSente(MFWorldStatus(world))));
-#endif
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYWIDTH
-  GSetPush(&(that->_worldsToExpand), (MFWorld*)world);  
+  // The MCTS and the alpha-beta expansions have no frontier
+  switch (that->_expansionType) {
+    case MFExpansionTypeValue:
+      MFFrontierPushSort(&(that->_worldsToExpand), (MFWorld*)world, 
+        MFWorldGetValue(world, 
+        MFModelStatusGetSente(MFWorldStatus(world))));
+      break;
+    case MFExpansionTypeWidth:
+      MFFrontierPushLast(&(that->_worldsToExpand), (MFWorld*)world);  
+      break;
+    case MFExpansionTypeDepthRandomWalk:
+      if (that->_expByDepthAppendPos == 0)
+        MFFrontierPushNext(&(that->_worldsToExpand), (MFWorld*)world);  
+      else
+        MFFrontierPushLast(&(that->_worldsToExpand), (MFWorld*)world);  
+      break;
+    default:
+      return;
+  }
+  MFAddWorldToHash(that, (MFWorld*)world);
+}
+
+// Add the MFWorld 'world' to the hash table of worlds of the 
+// MiniFrame 'that'
+// Do nothing if the world is already in the hash table
+void MFAddWorldToHash(MiniFrame* const that, MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK
-  if (that->_expByDepthAppendPos == 0)
-    GSetAppend(&(that->_worldsToExpand), (MFWorld*)world);  
-  else
-    GSetPush(&(that->_worldsToExpand), (MFWorld*)world);  
+  // If the world is already in the hash table, nothing to do
+  if (world->_isHashed)
+    return;
+  // If the hash table is full, double its size
+  if (that->_nbWorldsHash >= that->_nbBucketWorldsHash)
+    MFResizeWorldHash(that, that->_nbBucketWorldsHash * 2);
+  // Add the world at the tail of its bucket, so that the oldest 
+  // world is found first by MFSearchWorld
+  world->_hash = MFModelStatusHash(MFWorldStatus(world));
+  MFWorld** ptr = that->_worldsHash + 
+    (world->_hash & (unsigned long)(that->_nbBucketWorldsHash - 1));
+  while (*ptr != NULL)
+    ptr = &((*ptr)->_nextWorldHash);
+  world->_nextWorldHash = NULL;
+  *ptr = world;
+  world->_isHashed = true;
+  ++(that->_nbWorldsHash);
+}
+
+// Remove the MFWorld 'world' from the hash table of worlds of the 
+// MiniFrame 'that'
+// Do nothing if the world is not in the hash table
+void MFRemoveWorldFromHash(MiniFrame* const that, MFWorld* const world) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (world == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'world' is null");
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_MONTECARLOTREESEARCH
-  (void)that; (void)world;
+  // If the world is not in the hash table, nothing to do
+  if (!world->_isHashed)
+    return;
+  // Search the world in its bucket and unlink it
+  MFWorld** ptr = that->_worldsHash + 
+    (world->_hash & (unsigned long)(that->_nbBucketWorldsHash - 1));
+  while (*ptr != NULL && *ptr != world)
+    ptr = &((*ptr)->_nextWorldHash);
+  if (*ptr == world) {
+    *ptr = world->_nextWorldHash;
+    --(that->_nbWorldsHash);
+  }
+  world->_nextWorldHash = NULL;
+  world->_isHashed = false;
+}
+
+// Resize the hash table of worlds of the MiniFrame 'that' to 
+// 'nbBucket' buckets, 'nbBucket' must be a power of 2
+void MFResizeWorldHash(MiniFrame* const that, const int nbBucket) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    MiniFrameErr->_type = PBErrTypeNullPointer;
+    sprintf(MiniFrameErr->_msg, "'that' is null");
+    PBErrCatch(MiniFrameErr);
+  }
+  if (nbBucket <= 0 || (nbBucket & (nbBucket - 1)) != 0) {
+    MiniFrameErr->_type = PBErrTypeInvalidArg;
+    sprintf(MiniFrameErr->_msg, 
+      "'nbBucket' is not a power of 2 (%d)", nbBucket);
+    PBErrCatch(MiniFrameErr);
+  }
 #endif
+  // Allocate the new buckets, and a temporary array to memorize
+  // their tail
+  MFWorld** buckets = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFWorld*) * nbBucket);
+  MFWorld** tails = PBErrMalloc(MiniFrameErr, 
+    sizeof(MFWorld*) * nbBucket);
+  for (int iBucket = nbBucket; iBucket--;) {
+    buckets[iBucket] = NULL;
+    tails[iBucket] = NULL;
+  }
+  // Move the worlds from the old buckets to the new ones, keeping
+  // their order
+  for (int iBucket = 0; iBucket < that->_nbBucketWorldsHash; 
+    ++iBucket) {
+    MFWorld* world = that->_worldsHash[iBucket];
+    while (world != NULL) {
+      MFWorld* next = world->_nextWorldHash;
+      unsigned long jBucket = 
+        world->_hash & (unsigned long)(nbBucket - 1);
+      world->_nextWorldHash = NULL;
+      if (tails[jBucket] == NULL)
+        buckets[jBucket] = world;
+      else
+        tails[jBucket]->_nextWorldHash = world;
+      tails[jBucket] = world;
+      world = next;
+    }
+  }
+  // Replace the old buckets
+  free(tails);
+  free(that->_worldsHash);
+  that->_worldsHash = buckets;
+  that->_nbBucketWorldsHash = nbBucket;
 }
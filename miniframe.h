@@ -8,9 +8,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
 #include <string.h>
 #include <stdbool.h>
 #include <time.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "pberr.h"
 #include "pbmath.h"
 #include "gset.h"
@@ -21,6 +25,51 @@
 #define MF_DEFAULTTIMEEXPANSION 100
 // time_ms = clock() / MF_MILLISECTOCLOCKS
 #define MF_MILLISECTOCLOCKS (CLOCKS_PER_SEC * 0.001) 
+// Percentile of the costs of the steps of expansion used to predict 
+// the cost of the next step
+#define MF_STEPCOSTPERCENTILE 0.95
+// Rate of adaptation of the running percentile of the costs of the 
+// steps of expansion, in ]0.0, 1.0]
+#define MF_STEPCOSTRATE 0.1
+// Initial prediction of the cost of moving one world during a resize 
+// of the hash table of worlds, in millisecond
+#define MF_REHASHCOSTPERWORLD 0.00003
+// Nb of moves over which the time left on the game clock is spread, 
+// cf MFSetGameClock
+#define MF_GAMECLOCKNBMOVE 30
+// Time kept on the game clock as a safety margin, in millisecond
+#define MF_GAMECLOCKMARGIN 50.0
+// Max share of the time left on the game clock used for one move
+#define MF_GAMECLOCKMAXSHARE 0.25
+// Max ratio between the time used for one move and its planned 
+// budget
+#define MF_GAMECLOCKMAXFACTOR 3.0
+// Ratio applied to the budget of a move without alternative
+#define MF_GAMECLOCKFORCEDFACTOR 0.05
+// Ratio applied to the budget of a move when the best transition from
+// the current world changes, it decays by MF_GAMECLOCKSTABILITYDECAY
+// at each check where it stays the same, down to MF_GAMECLOCKMINFACTOR
+#define MF_GAMECLOCKINSTABILITYFACTOR 1.5
+#define MF_GAMECLOCKSTABILITYDECAY 0.8
+#define MF_GAMECLOCKMINFACTOR 0.4
+// Variation of the value of the best transition between two checks 
+// of the stability doubling the budget of a move, it depends on the 
+// scale of the values of the model
+#define MF_GAMECLOCKVOLATILITYSCALE 1.0
+// Rate of adaptation of the running averages of the game clock, in 
+// ]0.0, 1.0]
+#define MF_GAMECLOCKRATE 0.25
+// Nb of steps of expansion, or iterations of the MCTS, between two 
+// checks of the stability of the best transition
+#define MF_NBSTEPPERSTABILITYCHECK 256
+// Default margin of the best transition from the current world over 
+// the other ones above which the expansion stops early, cf 
+// MFSetSettledMargin, negative to never stop early
+#define MF_DEFAULTSETTLEDMARGIN -1.0
+// Nb of consecutive checks of the stability where the best transition
+// from the current world must stay the same before the expansion 
+// stops early
+#define MF_NBSTABLECHECKSETTLED 3
 // Default value for pruning during expansion
 #define MF_PRUNINGDELTAVAL 1000.0
 // Default maximum depth of expansion
@@ -30,7 +79,32 @@
 #define MF_EXPANSIONTYPE_BYWIDTH 1
 #define MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK 2
 #define MF_EXPANSIONTYPE_MONTECARLOTREESEARCH 3
+#define MF_EXPANSIONTYPE_ALPHABETA 4
+// Default expansion type of a new MiniFrame, it can be changed at 
+// runtime with MFSetExpansionType()
 #define MF_EXPANSIONTYPE MF_EXPANSIONTYPE_BYWIDTH
+// Nb of statuses searched by the alpha-beta expansion between two 
+// checks of the time limit
+#define MF_NBSEARCHPERCLOCKCHECK 256
+// Nb of entries in the table of best transitions of the alpha-beta 
+// expansion, must be a power of 2
+#define MF_NBALPHABETAENTRY 65536
+// Default nb of threads used during expansion
+#define MF_DEFAULTNBTHREAD 1
+// Default nb of best lines from the current world kept resolved by the
+// expansion, cf MFSetNbMultiPV
+#define MF_DEFAULTNBMULTIPV 1
+// Value removed from the value of a transition for its sente during 
+// a playout of the MCTS through it, to spread the threads sharing the 
+// tree over different paths
+#define MF_MCTSVIRTUALLOSS 1.0
+// Expansion states of a transition in the MCTS
+#define MF_MCTSNOTEXPANDED 0
+#define MF_MCTSEXPANDING 1
+#define MF_MCTSEXPANDED 2
+// Nb of worlds of the frontier per thread whose reached worlds are 
+// created in advance by the parallel expansion
+#define MF_NBPREFETCHPERTHREAD 8
 // Use of pruning
 #define MF_USEPRUNING true
 // Use telemetry
@@ -38,21 +112,72 @@
 // Reuse world
 #define MF_REUSEWORLD true
 // Use of depth limit
-// TODO: Doesn't work, the world get dropped from teh set of worlds to 
-// expand but nothing is done, so the reference to the world is lost
 #define MF_LIMITDEPTH true
+// Initial number of buckets in the hash table of worlds, must be a 
+// power of 2
+#define MF_NBWORLDHASHBUCKET 1024
+// Number of MFWorld per block of memory in the pool of worlds
+#define MF_NBWORLDPERPOOLBLOCK 256
+// Number of MFTransition per block of memory in the pool of worlds, 
+// must be at least MF_NBMAXTRANSITION + MF_NBTRANSHEADER
+#define MF_NBTRANSPERPOOLBLOCK 1024
+// Use of compact transitions, the world to which a transition is 
+// applied is derived from the position of the transition in the array
+// of transitions of this world instead of being memorized in each 
+// transition
+// In this mode MFTransitionFromWorld is only valid for the transitions
+// of a MFWorld, not for standalone MFTransition
+#define MF_COMPACTTRANSITION false
+// Nb of MFTransition slots preceding the array of transitions of a 
+// world, used to memorize the world in compact transitions mode
+#if MF_COMPACTTRANSITION
+#define MF_NBTRANSHEADER 1
+#else
+#define MF_NBTRANSHEADER 0
+#endif
+// Number of transitions reaching a world stored inside the world, 
+// the following ones are stored in an allocated array
+#define MF_NBINLINESOURCE 2
+// Initial size of the array of worlds to expand, it grows as needed,
+// must be a power of 2
+#define MF_NBINITFRONTIER 256
+// Initial size of the stack used to update backward the forecast 
+// values, it grows as needed
+#define MF_NBINITBACKPROPSTACK 64
+// Default nb of expanded worlds between two updates backward of the 
+// forecast values, if 1 the update occurs after each expanded world
+#define MF_DEFAULTNBEXPANSIONPERBACKPROP 1
+// Initial size of the heap of worlds waiting for the update backward
+// of their forecast values, it grows as needed
+#define MF_NBINITDIRTYWORLD 64
+// Initial size of the arrays memorizing the principal variation, they
+// grow as needed
+#define MF_NBINITPV 32
  
 // =========== Interface with the model implementation =============
 
 #include "miniframe-model.h"
 
+#if MF_NBMAXTRANSITION + MF_NBTRANSHEADER > MF_NBTRANSPERPOOLBLOCK
+#error "MF_NBTRANSPERPOOLBLOCK must be at least MF_NBMAXTRANSITION + \
+MF_NBTRANSHEADER"
+#endif
+
 // ================= Data structure ===================
 typedef struct MFWorld MFWorld;
+typedef struct MFWorldPool MFWorldPool;
 typedef struct MFTransition {
   // User defined transition
   MFModelTransition _transition;
+#if MF_COMPACTTRANSITION
+  // Index of this transition in the array of transitions of the world
+  // to which it is applied, the world is memorized in the slot 
+  // preceding this array
+  int _iTrans;
+#else
   // Reference to the world to which this action is applied
   MFWorld* _fromWorld;
+#endif
   // Reference to the reached world through this action
   // if null it means this action has not been computed
   MFWorld* _toWorld;
@@ -60,38 +185,386 @@ typedef struct MFTransition {
   float _values[MF_NBMAXACTOR];
 } MFTransition;
 
+// Statistics of the MCTS expansion on a transition, kept apart from 
+// the transition to not weigh on the other expansion types
+typedef struct MFMCTSStats {
+  // Nb of playouts of the MCTS through the transition, including the
+  // ones in progress, its values are the average of the values at the 
+  // end of these playouts
+  _Atomic long _nbVisit;
+  // Sum of the values at the end of the playouts through the 
+  // transition for each actor, minus the virtual loss of the ones in 
+  // progress
+  _Atomic float _sumValues[MF_NBMAXACTOR];
+  // Expansion state of the transition, MF_MCTSNOTEXPANDED, 
+  // MF_MCTSEXPANDING or MF_MCTSEXPANDED, its reached world can be read
+  // by other threads only once it's MF_MCTSEXPANDED
+  _Atomic int _expandState;
+} MFMCTSStats;
+
 typedef struct MFWorld {
   // User defined status of the world
   MFModelStatus _status;
-  // Set of transitions reaching this world
-  GSet _sources;
+  // Transitions reaching this world, the first MF_NBINLINESOURCE ones 
+  // are stored in _sources, the following ones in _extraSources
+  MFTransition* _sources[MF_NBINLINESOURCE];
+  // Array of transitions reaching this world beyond the 
+  // MF_NBINLINESOURCE first ones
+  MFTransition** _extraSources;
+  // Nb of transitions reaching this world
+  int _nbSource;
+  // Size of the array _extraSources
+  int _nbExtraSourceAlloc;
   // Array of value of this world from the pov of each actor
   float _values[MF_NBMAXACTOR];
-  // Array to memorize the transitions from this world instance
-  MFTransition _transitions[MF_NBMAXTRANSITION];
+  // Array to memorize the transitions from this world instance, sized
+  // to _nbTransition, null if there is no transition
+  MFTransition* _transitions;
   // Number of transitions from this world
   int _nbTransition;
+  // Index of the best transition from this world for each actor, -1 if
+  // there is none, updated each time a transition changes
+  int _iBestTrans[MF_NBMAXACTOR];
+  // Flag to memorize if the status of this world is an end status
+  bool _isEnd;
+  // Nb of transitions from this world reaching a world with an end 
+  // status
+  int _nbEndChild;
+  // Epoch of the last update backward of forecast values which has 
+  // visited this world, 0 if none
+  unsigned long _visitEpoch;
+  // Epoch of the last MFSetCurWorld which has kept this world in the 
+  // tree of the MCTS, 0 if none
+  unsigned long _keepEpoch;
+  // Index of this world in the principal variation of the MiniFrame,
+  // only meaningful if the world is at this index in the principal 
+  // variation, -1 if it has never been in it
+  int _iPV;
   // Depth, internal variable used during expansion
   int _depth;
+  // Hash of the status, used to index the world in the MiniFrame
+  unsigned long _hash;
+  // Next world in the same bucket of the hash table of the MiniFrame,
+  // or in the list of released worlds of its pool
+  MFWorld* _nextWorldHash;
+  // Flag to memorize if the world is in the hash table of the MiniFrame
+  bool _isHashed;
+  // Pool from which the world has been allocated, null if it has been
+  // allocated with malloc
+  MFWorldPool* _pool;
+  // Array of statistics of the MCTS expansion for each transition from
+  // this world, null if the world is not in the tree of the MCTS
+  MFMCTSStats* _mctsStats;
 } MFWorld;
 
+typedef struct MFWorldPoolBlock MFWorldPoolBlock;
+typedef struct MFWorldPoolBlock {
+  // Next block in the pool
+  MFWorldPoolBlock* _next;
+  // Memory for the worlds
+  MFWorld _worlds[MF_NBWORLDPERPOOLBLOCK];
+} MFWorldPoolBlock;
+
+typedef struct MFTransitionPoolBlock MFTransitionPoolBlock;
+typedef struct MFTransitionPoolBlock {
+  // Next block in the pool
+  MFTransitionPoolBlock* _next;
+  // Memory for the transitions
+  MFTransition _transitions[MF_NBTRANSPERPOOLBLOCK];
+} MFTransitionPoolBlock;
+
+typedef struct MFWorldPool {
+  // Chained list of the blocks of memory, the head block is the one 
+  // currently used for allocation
+  MFWorldPoolBlock* _blocks;
+  // Nb of worlds already allocated in the head block
+  int _nbUsedInBlock;
+  // Chained list of the released worlds, available for reuse
+  MFWorld* _freeWorlds;
+  // Chained list of the blocks of memory for the transitions, the head
+  // block is the one currently used for allocation
+  MFTransitionPoolBlock* _transBlocks;
+  // Nb of transitions already allocated in the head block
+  int _nbUsedInTransBlock;
+  // Chained lists of the released arrays of transitions, available for
+  // reuse, indexed by the size of the arrays
+  MFTransition* _freeTransitions[MF_NBMAXTRANSITION + MF_NBTRANSHEADER + 1];
+} MFWorldPool;
+
+typedef struct MFFrontierElem {
+  // World waiting to be expanded
+  MFWorld* _world;
+  // Priority of the world, the one with highest priority is expanded
+  // first
+  float _priority;
+  // Order of insertion of the world, between worlds of same priority 
+  // the last inserted one is expanded first
+  unsigned long _order;
+} MFFrontierElem;
+
+typedef struct MFFrontier {
+  // Flag to memorize if the worlds are sorted by priority, in which 
+  // case they are memorized in the binary heap, else in the ring buffer
+  bool _isSorted;
+  // Binary heap of the worlds waiting to be expanded, the next one to
+  // be expanded is at index 0
+  MFFrontierElem* _elems;
+  // Nb of insertions since the creation of the frontier
+  unsigned long _nbInsert;
+  // Ring buffer of the worlds waiting to be expanded, the next one to 
+  // be expanded is the last one
+  MFWorld** _worlds;
+  // Index in _worlds of the first world
+  int _head;
+  // Nb of worlds in the heap or the ring buffer
+  int _nbWorld;
+  // Size of the array _elems or _worlds, always a power of 2
+  int _nbAlloc;
+} MFFrontier;
+
+typedef struct MFTimeManager {
+  // Time at which the expansion has started, in millisecond on the 
+  // monotonic clock
+  double _start;
+  // Time, in millisecond from the start, after which the expansion 
+  // doesn't start a new step
+  double _softDeadline;
+  // Time, in millisecond from the start, at which the expansion 
+  // interrupts the step in progress
+  double _hardDeadline;
+  // Running percentile of the cost of one step of expansion, in 
+  // millisecond, negative until the first step
+  double _stepCost;
+  // Time planned for the expansion, in millisecond, from which the 
+  // soft deadline is adjusted to the stability of the search, 0.0 if
+  // the deadlines are fixed
+  double _budget;
+  // Index of the best transition from the current world at the last
+  // check of the stability, -1 if there was no check
+  int _iBestTrans;
+  // Nb of consecutive checks where the best transition has not changed
+  int _nbStableCheck;
+  // Value of the best transition at the last check of the stability
+  float _bestValue;
+  // Running average of the variation of the value of the best 
+  // transition between two checks of the stability
+  float _volatility;
+} MFTimeManager;
+
+typedef struct MFExpansionWork {
+  // Nb of worlds expanded: the worlds whose transitions have been 
+  // computed by the expansion by value, width or depth, the worlds 
+  // added to the tree of the MCTS, the statuses searched through their
+  // transitions by the alpha-beta
+  long _nbExpandedWorld;
+  // Nb of evaluations of a status by the model
+  long _nbEvaluation;
+  // Nb of playouts of the MCTS
+  long _nbPlayout;
+} MFExpansionWork;
+
+typedef struct MFMCTSTree {
+  // MiniFrame for which the tree is searched
+  const struct MiniFrame* _mf;
+  // Root of the tree
+  MFWorld* _root;
+  // Pool from which the worlds of the tree are allocated
+  MFWorldPool* _pool;
+  // Set of the worlds of the tree
+  GSet* _worlds;
+  // Pool and set used by the trees of the worker threads
+  MFWorldPool _ownPool;
+  GSet _ownWorlds;
+  // Flag to memorize if the tree is searched by several threads at
+  // the same time, in which case the values and best transitions of
+  // its worlds are updated only once the search is over
+  bool _isShared;
+  // Thread searching the tree, if it's a worker thread
+  pthread_t _thread;
+  // State of the random generator of the playouts
+  unsigned int _rndState;
+  // Time manager of the search, each thread predicts the cost of its 
+  // own iterations
+  MFTimeManager _timeManager;
+  // Work done by the search, and the budget of work of the search
+  MFExpansionWork _work;
+  MFExpansionWork _workBudget;
+  // Max depth reached during the search
+  int _maxDepth;
+} MFMCTSTree;
+
+// Job of the parallel expansion: computation of the status reached by 
+// the '_iTrans'-th transition of '_fromWorld', then creation of its 
+// world
+typedef struct MFExpansionJob {
+  // World from which the transition is applied
+  MFWorld* _fromWorld;
+  // Index of the transition
+  int _iTrans;
+  // Prefetched worlds where to memorize the status and created world
+  struct MFPrefetchedWorld* _slot;
+  // Hash of the status reached by the transition
+  unsigned long _hash;
+} MFExpansionJob;
+
+// Worlds created in advance by the parallel expansion from a world of 
+// the frontier
+typedef struct MFPrefetchedWorld {
+  // World of the frontier, null if the slot is free
+  MFWorld* _world;
+  // Worlds reached by the transitions of the world of the frontier, 
+  // null for the transitions which were already expanded or whose 
+  // world has been used
+  MFWorld* _toWorlds[MF_NBMAXTRANSITION];
+  // Statuses reached by the transitions of the world of the frontier
+  // whose world has not been created as it would be reused, valid if 
+  // their flag is set
+  MFModelStatus _statuses[MF_NBMAXTRANSITION];
+  bool _hasStatus[MF_NBMAXTRANSITION];
+} MFPrefetchedWorld;
+
+// Thread of the parallel expansion and its work-stealing deque of jobs
+typedef struct MFExpansionThread {
+  // Parallel expansion the thread belongs to
+  struct MFParallelExpansion* _expansion;
+  // Pool from which the thread allocates the worlds it creates
+  MFWorldPool* _pool;
+  // Deque of indices of jobs, the thread pops its own jobs at the 
+  // bottom and the other threads steal them at the top
+  int* _jobs;
+  _Atomic long _top;
+  _Atomic long _bottom;
+  // Nb of worlds created by the thread during the current round
+  long _nbEvaluation;
+  // Thread, unused for the calling thread
+  pthread_t _thread;
+} MFExpansionThread;
+
+// Parallel expansion, the worlds reached from the next worlds of the 
+// frontier are created by the threads in rounds, while the calling 
+// thread links them to the graph between rounds
+typedef struct MFParallelExpansion {
+  // Worlds created in advance
+  MFPrefetchedWorld* _prefetched;
+  // Nb of slots in _prefetched
+  int _nbPrefetched;
+  // Jobs of the current round
+  MFExpansionJob* _jobs;
+  // Nb of jobs of the current round
+  int _nbJob;
+  // Threads, the first one is the calling thread
+  MFExpansionThread* _threads;
+  // Nb of threads
+  int _nbThread;
+  // Barrier synchronizing the start and end of rounds
+  pthread_barrier_t _barrier;
+  // Flag to memorize if the current round creates the worlds, else it
+  // computes their statuses
+  bool _isCreating;
+  // Flag to stop the worker threads
+  bool _isOver;
+} MFParallelExpansion;
+
+typedef struct MFBackpropFrame {
+  // World whose forecast values are propagated to its sources
+  MFWorld* _world;
+  // Index of the next source of _world to be updated
+  int _iSource;
+  // Forecast values propagated to the sources of _world
+  float _values[MF_NBMAXACTOR];
+} MFBackpropFrame;
+
+typedef struct MFAlphaBetaEntry {
+  // Hash of the status of the entry
+  unsigned long _hash;
+  // Index of the best transition of the status during its last search,
+  // -1 if the entry is empty
+  int _iBestTrans;
+} MFAlphaBetaEntry;
+
+// Expansion types, in the same order as the MF_EXPANSIONTYPE_xxx
 typedef enum MFExpansionType {
   MFExpansionTypeValue,
-  MFExpansionTypeWidth
+  MFExpansionTypeWidth,
+  MFExpansionTypeDepthRandomWalk,
+  MFExpansionTypeMCTS,
+  MFExpansionTypeAlphaBeta
 } MFExpansionType;
   
 typedef struct MiniFrame {
   // Nb of steps
   unsigned int _nbStep;
+  // Expansion type
+  MFExpansionType _expansionType;
   // Current world instance
   MFWorld* _curWorld;
   // All the computed world instances, ordered by their value from the
   // pov of the preempting player at the previous step
   GSet _worldsComputed;
-  // Set of world waiting to be expanded
-  GSet _worldsToExpand;
+  // Frontier of worlds waiting to be expanded
+  MFFrontier _worldsToExpand;
+  // Stack used to update backward the forecast values
+  MFBackpropFrame* _backpropStack;
+  // Size of the array _backpropStack
+  int _nbAllocBackprop;
+  // Epoch of the current update backward of forecast values, starts
+  // at 1 and is moved past the epochs used by each update at its end
+  unsigned long _backpropEpoch;
+  // Nb of expanded worlds between two updates backward of the forecast
+  // values
+  int _nbExpansionPerBackprop;
+  // Max-heap on the depth of the worlds whose forecast values have 
+  // changed and not yet been updated backward
+  MFWorld** _dirtyWorlds;
+  // Nb of worlds in _dirtyWorlds
+  int _nbDirtyWorld;
+  // Size of the array _dirtyWorlds
+  int _nbAllocDirty;
+  // Principal variation from the current world: best transition from
+  // each world of the line, and worlds of the line, the last one being
+  // the world reached by the last transition or null if it has not 
+  // been computed
+  const MFTransition** _pv;
+  MFWorld** _pvWorlds;
+  // Nb of transitions in the principal variation
+  int _pvLength;
+  // Size of the arrays _pv and _pvWorlds
+  int _nbAllocPV;
+  // Actor whose best transitions are followed in the worlds without
+  // sente of the principal variation
+  int _pvActor;
+  // Flag to memorize if the principal variation is up to date, it is
+  // reset when the best transition of one of its worlds changes
+  bool _isPVValid;
+  // Hash table of the computed worlds and worlds to expand, indexed
+  // by the hash of their status
+  MFWorld** _worldsHash;
+  // Nb of buckets in the hash table of worlds
+  int _nbBucketWorldsHash;
+  // Nb of worlds in the hash table of worlds
+  int _nbWorldsHash;
+  // Cost of moving one world during the last resize of the hash table
+  // of worlds, in millisecond
+  double _rehashCostPerWorld;
+  // Pool from which the worlds of the MiniFrame are allocated
+  MFWorldPool _worldPool;
+  // Pools from which the worker threads allocate the worlds they add 
+  // to the tree of the MiniFrame
+  MFWorldPool** _threadPools;
+  // Nb of pools in _threadPools
+  int _nbThreadPool;
   // Time limit for expansion, in millisecond
   float _maxTimeExpansion;
+  // Flag to memorize if the time for expansion is allocated from the
+  // game clock, cf MFSetGameClock
+  bool _useGameClock;
+  // Time left on the game clock, in millisecond
+  float _gameClockTimeLeft;
+  // Time added to the game clock after each move, in millisecond
+  float _gameClockIncrement;
+  // Running average of the nb of transitions from the current world 
+  // at the start of the expansions allocated from the game clock
+  float _avgNbTrans;
   // Time unused during expansion, in millisecond
   float _timeUnusedExpansion;
   // Flag to activate the reuse of previously computed same world
@@ -101,20 +574,58 @@ typedef struct MiniFrame {
   float _percWorldReused;
   // The clock considered has start during expansion
   clock_t _startExpandClock;
+  // Time manager of the expansion
+  MFTimeManager _timeManager;
+  // Budget of work of the expansion, cf MFSetExpansionBudget
+  MFExpansionWork _workBudget;
+  // Work done during the last MFExpand
+  MFExpansionWork _work;
   // Maximum depth during expansion, if -1 there is no limit
   int _maxDepthExp;
   // Value for pruning during expansion
   float _pruningDeltaVal;
+  // Margin of the best transition from the current world above which 
+  // the expansion stops early, negative to never stop early
+  float _settledMargin;
   // Nb of world not found in MFSetCurWorld
   int _nbWorldNotFound;
   // Nb of tries in the MCTS
   int _nbTryMTCS;
+  // Nb of threads used during expansion
+  int _nbThread;
+  // Flag to memorize if the threads share one tree during expansion
+  bool _treeParallel;
+  // Nb of best lines from the current world kept resolved by the 
+  // expansion
+  int _nbMultiPV;
+  // Thread expanding the MiniFrame in background while pondering
+  pthread_t _ponderThread;
+  // Flag to memorize if the MiniFrame is pondering
+  bool _isPondering;
+  // Flag to request the expansion in progress to stop
+  _Atomic bool _stopExpand;
   // Max depth reached during last MFExpand
   int _maxDepthExpReached;
-#if MF_EXPANSIONTYPE == MF_EXPANSIONTYPE_BYDEPTH_RANDOMWALK
-  // Internal flag
+  // Internal flag of the expansion by depth
   int _expByDepthAppendPos;
-#endif
+  // Epoch of the current MFSetCurWorld of the MCTS, the worlds 
+  // stamped with it are kept in its tree, starts at 1 and is 
+  // incremented at the end of each MFSetCurWorld
+  unsigned long _keepEpoch;
+  // Index of the actor from whose pov the alpha-beta search is done
+  int _searchActor;
+  // Nb of statuses searched during the last MFExpand
+  long _nbSearch;
+  // Flag to memorize if the current iteration of the search has been 
+  // interrupted by the time limit
+  bool _isSearchAborted;
+  // Flag to memorize if the current iteration of the search has been 
+  // cut by its depth before reaching the end of the game
+  bool _isSearchCut;
+  // Table of the best transitions of the statuses searched by the 
+  // alpha-beta, indexed by the hash of the statuses, searched first at
+  // the next iteration, null until the alpha-beta is used
+  MFAlphaBetaEntry* _alphaBetaTable;
 } MiniFrame;
 
 // ================ Functions declaration ====================
@@ -128,12 +639,212 @@ MiniFrame* MiniFrameCreate(const MFModelStatus* const initStatus);
 // Return the new MFWorld
 MFWorld* MFWorldCreate(const MFModelStatus* const status);
 
+// Create a new MFWorld with a copy of the MFModelStatus 'status', 
+// allocated from the MFWorldPool 'pool'
+// If 'pool' is null the MFWorld is allocated with malloc
+// The array of transitions of the MFWorld is sized to the number of
+// transitions from 'status'
+// Return the new MFWorld
+MFWorld* MFWorldCreateFromPool(MFWorldPool* const pool, 
+  const MFModelStatus* const status);
+
 // Create a new static MFWorld with a copy of the MFModelStatus 'status'
 // Return the new MFWorld
 MFWorld MFWorldCreateStatic(const MFModelStatus* const status);
 
+// Create a new static MFWorldPool
+// Return the new MFWorldPool
+MFWorldPool MFWorldPoolCreateStatic(void);
+
+// Free the memory used by the properties of the MFWorldPool 'that'
+// All the MFWorld and arrays of MFTransition allocated from the pool 
+// are freed at once, the memory used by the properties of the MFWorld
+// must have been freed before
+void MFWorldPoolFreeStatic(MFWorldPool* const that);
+
+// Get the memory for one MFWorld from the MFWorldPool 'that'
+// Released worlds are reused first
+// Return the uninitialised MFWorld
+MFWorld* MFWorldPoolAlloc(MFWorldPool* const that);
+
+// Give back the memory of the MFWorld 'world' to the MFWorldPool 
+// 'that' for later reuse
+void MFWorldPoolRelease(MFWorldPool* const that, MFWorld* const world);
+
+// Get the memory for an array of 'nb' MFTransition from the 
+// MFWorldPool 'that', 'nb' must be in 
+// [1, MF_NBMAXTRANSITION + MF_NBTRANSHEADER]
+// Released arrays of same size are reused first
+// Return the uninitialised array
+MFTransition* MFWorldPoolAllocTrans(MFWorldPool* const that, 
+  const int nb);
+
+// Give back the memory of the array of 'nb' MFTransition 
+// 'transitions' to the MFWorldPool 'that' for later reuse
+void MFWorldPoolReleaseTrans(MFWorldPool* const that, 
+  MFTransition* const transitions, const int nb);
+
+// Return the time on the monotonic clock in millisecond
+double MFGetWallClockMs(void);
+
+// Create a new static MFTimeManager, started now with no time to 
+// expand
+// Return the new MFTimeManager
+MFTimeManager MFTimeManagerCreateStatic(void);
+
+// Start the MFTimeManager 'that' at the time 'start', in millisecond 
+// on the monotonic clock
+void MFTimeManagerStart(MFTimeManager* const that, const double start);
+
+// Set the soft and hard deadlines of the MFTimeManager 'that' to 
+// 'soft' and 'hard', in millisecond from its start
+// No step is started if it's predicted to end after the soft 
+// deadline, the step in progress is interrupted at the hard deadline
+// The deadlines are fixed, cf MFTimeManagerSetBudget()
+// The stability of the previous search is forgotten
+void MFTimeManagerSetDeadlines(MFTimeManager* const that, 
+  const double soft, const double hard);
+
+// Set the time planned for the expansion of the MFTimeManager 'that'
+// to 'budget' and its hard deadline to 'hard', in millisecond from its
+// start
+// The soft deadline is initially the budget, then it's adjusted to the
+// stability of the search by MFTimeManagerCheckStability(), within 
+// the hard deadline
+void MFTimeManagerSetBudget(MFTimeManager* const that, 
+  const double budget, const double hard);
+
+// Update the stability of the search of the MFTimeManager 'that' with
+// the index 'iBestTrans' of the best transition from the current 
+// world and its value 'bestValue', and adjust its soft deadline
+// The budget is increased when the best transition changes or its 
+// value varies, and decreased while it stays the same
+// The soft deadline is not adjusted if the MFTimeManager has no 
+// budget, do nothing if 'iBestTrans' is -1
+void MFTimeManagerCheckStability(MFTimeManager* const that, 
+  const int iBestTrans, const float bestValue);
+
+// Return true if the best transition from the current world of the 
+// search of the MFTimeManager 'that' is settled, given 'margin' its 
+// margin over the other transitions, else false
+// It's settled if it has no alternative, i.e. 'margin' is FLT_MAX, or
+// if it has stayed the same for MF_NBSTABLECHECKSETTLED checks of the
+// stability and 'margin' is at least 'minMargin'
+// Never settled if 'minMargin' is negative
+bool MFTimeManagerIsSettled(const MFTimeManager* const that, 
+  const float margin, const float minMargin);
+
+// Return the margin of the 'iBestTrans'-th of the 'nbTrans' 
+// transitions whose values are 'values' over the other ones, 
+// ignoring the ones leading to a proven world, i.e. an end world, 
+// whose value is below the best one
+// Return FLT_MAX if there is no other transition, -FLT_MAX if 
+// 'iBestTrans' is -1
+float MFTransitionsGetMargin(const int nbTrans, 
+  const float* const values, const bool* const isProven, 
+  const int iBestTrans);
+
+// Return the time elapsed since the start of the MFTimeManager 'that',
+// in millisecond
+double MFTimeManagerGetElapsed(const MFTimeManager* const that);
+
+// Return the time left until the hard deadline of the MFTimeManager 
+// 'that', in millisecond, negative if it's over
+double MFTimeManagerGetTimeLeft(const MFTimeManager* const that);
+
+// Return true if a step of cost 'cost', in millisecond, started now 
+// ends before the soft deadline of the MFTimeManager 'that', else 
+// false
+bool MFTimeManagerHasTimeFor(const MFTimeManager* const that, 
+  const double cost);
+
+// Return true if the hard deadline of the MFTimeManager 'that' is 
+// reached, else false
+bool MFTimeManagerIsOver(const MFTimeManager* const that);
+
+// Return the predicted cost of the next step for the MFTimeManager 
+// 'that', in millisecond: the MF_STEPCOSTPERCENTILE percentile of the
+// costs of the previous steps, 0.0 if there was none
+double MFTimeManagerGetStepCost(const MFTimeManager* const that);
+
+// Update the running percentile of the costs of the steps of the 
+// MFTimeManager 'that' with the cost 'cost', in millisecond, of the 
+// last step
+void MFTimeManagerAddStepCost(MFTimeManager* const that, 
+  const double cost);
+
+// Forget the costs of the previous steps of the MFTimeManager 'that'
+void MFTimeManagerResetStepCost(MFTimeManager* const that);
+
+// Create a new static MFExpansionWork with no work
+// Return the new MFExpansionWork
+MFExpansionWork MFExpansionWorkCreateStatic(void);
+
+// Return true if the work 'that' is below the budget 'budget' for all
+// the kinds of work, else false
+// A kind of work whose budget is 0 or less is not limited
+bool MFExpansionWorkIsWithin(const MFExpansionWork* const that, 
+  const MFExpansionWork* const budget);
+
+// Add the work 'work' to the MFExpansionWork 'that'
+void MFExpansionWorkAdd(MFExpansionWork* const that, 
+  const MFExpansionWork* const work);
+
+// Create a new static MFFrontier, whose worlds are sorted by priority
+// if 'isSorted' is true, else expanded in their order of insertion
+// Return the new MFFrontier
+MFFrontier MFFrontierCreateStatic(const bool isSorted);
+
+// Free the memory used by the properties of the MFFrontier 'that'
+// The worlds in the frontier are not freed
+void MFFrontierFreeStatic(MFFrontier* const that);
+
+// Get the nb of worlds in the MFFrontier 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+int MFFrontierGetNb(const MFFrontier* const that);
+
+// Get the 'iWorld'-th world in the MFFrontier 'that'
+// The worlds are not ordered by their order of expansion
+#if BUILDMODE != 0
+static inline
+#endif
+MFWorld* MFFrontierGet(const MFFrontier* const that, const int iWorld);
+
+// Get the world of the MFFrontier 'that' which is popped after 'iNext'
+// other worlds if no world is pushed in the meantime
+// If the frontier is sorted, only the next world (iNext equals 0) is 
+// exact, the following ones are the ones near the top of the heap
+#if BUILDMODE != 0
+static inline
+#endif
+MFWorld* MFFrontierPeek(const MFFrontier* const that, const int iNext);
+
+// Add the MFWorld 'world' to the MFFrontier 'that' as the next one to
+// be expanded
+void MFFrontierPushNext(MFFrontier* const that, MFWorld* const world);
+
+// Add the MFWorld 'world' to the sorted MFFrontier 'that' with the 
+// priority 'priority', worlds with highest priority are expanded first
+void MFFrontierPushSort(MFFrontier* const that, MFWorld* const world,
+  const float priority);
+
+// Add the MFWorld 'world' to the unsorted MFFrontier 'that' as the 
+// last one to be expanded
+void MFFrontierPushLast(MFFrontier* const that, MFWorld* const world);
+
+// Remove the next world to be expanded from the MFFrontier 'that'
+// Return the removed world
+MFWorld* MFFrontierPop(MFFrontier* const that);
+
+// Remove the 'iWorld'-th world from the MFFrontier 'that'
+// Return the removed world
+MFWorld* MFFrontierRemove(MFFrontier* const that, const int iWorld);
+
 // Create a new static MFTransition for the MFWorld 'world' with the
 // MFModelTransition 'transition'
+// 'world' is null for the transitions of a static world
 // Return the new MFTransition
 MFTransition MFTransitionCreateStatic(const MFWorld* const world,
   const MFModelTransition* const transition);
@@ -159,11 +870,11 @@ static inline
 #endif
 const GSet* MFWorldsComputed(const MiniFrame* const that);
 
-// Get the GSet of worlds to expand of the MiniFrame 'that'
+// Get the MFFrontier of worlds to expand of the MiniFrame 'that'
 #if BUILDMODE != 0
 static inline
 #endif
-const GSet* MFWorldsToExpand(const MiniFrame* const that);
+const MFFrontier* MFWorldsToExpand(const MiniFrame* const that);
 
 // Get the nb of world To expande of the MiniFrame 'that'
 #if BUILDMODE != 0
@@ -200,6 +911,16 @@ void MFAddWorldToComputed(MiniFrame* const that, \
 // MiniFrame 'that'
 void MFAddWorldToExpand(MiniFrame* const that, \
   const MFWorld* const world);
+
+// Add the MFWorld 'world' to the hash table of worlds of the 
+// MiniFrame 'that'
+// Do nothing if the world is already in the hash table
+void MFAddWorldToHash(MiniFrame* const that, MFWorld* const world);
+
+// Remove the MFWorld 'world' from the hash table of worlds of the 
+// MiniFrame 'that'
+// Do nothing if the world is not in the hash table
+void MFRemoveWorldFromHash(MiniFrame* const that, MFWorld* const world);
   
 // Get the time limit for expansion of the MiniFrame 'that'
 #if BUILDMODE != 0
@@ -233,6 +954,8 @@ static inline
 clock_t MFGetStartExpandClock(const MiniFrame* const that);
 
 // Set the clock considered has start during expansion to 'c'
+// The time limit of the expansion is measured on the monotonic clock,
+// from now minus the time used by the process since 'c'
 #if BUILDMODE != 0
 static inline
 #endif
@@ -240,14 +963,87 @@ void MFSetStartExpandClock(MiniFrame* const that, clock_t c);
 
 // Set the time limit for expansion of the MiniFrame 'that' to 
 // 'timeLimit', in millisecond
-// The time is measured with the function clock(), see "man clock"
-// for details
+// The time is measured on the monotonic clock, a step of expansion is
+// started only if the running percentile of the costs of the previous
+// steps predicts it ends before the time limit
+// Stop the allocation of the time from the game clock
 #if BUILDMODE != 0
 static inline
 #endif
 void MFSetMaxTimeExpansion(MiniFrame* const that, \
   const float timeLimit);
 
+// Set the game clock of the MiniFrame 'that' to 'timeLeft', the time 
+// left for the rest of the game, and 'increment', the time added after
+// each move, in millisecond, and allocate from it the time of the 
+// following expansions instead of the time limit for expansion
+// The budget of a move is the time left spread over 
+// MF_GAMECLOCKNBMOVE moves plus the increment, scaled by the nb of 
+// transitions from the current world relative to their average over 
+// the game, then adjusted during the expansion to the stability of 
+// the best transition and its value, within MF_GAMECLOCKMAXFACTOR 
+// times the budget and MF_GAMECLOCKMAXSHARE of the time left
+// Each MFExpand() withdraws the time it used from the game clock and 
+// adds the increment, the game clock should be set again before each
+// move to follow the real one
+// The pondering is not allocated from the game clock, it keeps 
+// expanding by periods of the time limit for expansion
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetGameClock(MiniFrame* const that, const float timeLeft,
+  const float increment);
+
+// Set the budget of work of the expansion of the MiniFrame 'that' to
+// 'nbExpandedWorld' worlds expanded, 'nbEvaluation' evaluations of a 
+// status by the model and 'nbPlayout' playouts of the MCTS, a budget 
+// of 0 or less doesn't limit its kind of work
+// cf MFExpansionWork for the meaning of the worlds expanded for each 
+// expansion type, the nb of playouts only limits the MCTS
+// The expansion stops at the first of its time limit and its budgets,
+// the step in progress is completed so the budget may be exceeded by
+// one step, except for the alpha-beta which aborts its iteration in 
+// progress
+// The budget is shared equally between the threads of the MCTS, 
+// whose tree may stop growing before the end of its budget of worlds
+// expanded once it contains all the reachable worlds
+// For reproducible expansions, e.g. to benchmark, use one thread and
+// a time limit long enough for the budget to be reached first, e.g. 
+// FLT_MAX
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetExpansionBudget(MiniFrame* const that, 
+  const long nbExpandedWorld, const long nbEvaluation, 
+  const long nbPlayout);
+
+// Get the budget of work of the expansion of the MiniFrame 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+const MFExpansionWork* MFGetExpansionBudget(
+  const MiniFrame* const that);
+
+// Get the work done during the last MFExpand of the MiniFrame 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+const MFExpansionWork* MFGetExpansionWork(const MiniFrame* const that);
+
+// Return true if the time of the expansions of the MiniFrame 'that' 
+// is allocated from its game clock, else false
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFUsesGameClock(const MiniFrame* const that);
+
+// Get the time left on the game clock of the MiniFrame 'that', in 
+// millisecond
+#if BUILDMODE != 0
+static inline
+#endif
+float MFGetGameClockTimeLeft(const MiniFrame* const that);
+
 // Return the MFModelStatus of the MFWorld 'that'
 #if BUILDMODE != 0
 static inline
@@ -258,6 +1054,26 @@ const MFModelStatus* MFWorldStatus(const MFWorld* const that);
 // expand anymore
 void MFExpand(MiniFrame* that);
 
+// Start expanding the MiniFrame 'that' on a background thread until 
+// MFStopPondering or MFSetCurWorld is called, typically during the 
+// turn of the opponent
+// While pondering, the MiniFrame must not be used by other functions 
+// than MFStopPondering, MFIsPondering and MFSetCurWorld
+// The alpha-beta expansion, which doesn't memorize the worlds it 
+// searches, doesn't ponder
+void MFStartPondering(MiniFrame* const that);
+
+// Stop the pondering of the MiniFrame 'that' and wait for its 
+// background thread to end
+// Do nothing if the MiniFrame is not pondering
+void MFStopPondering(MiniFrame* const that);
+
+// Return true if the MiniFrame 'that' is pondering, else false
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFIsPondering(const MiniFrame* const that);
+
 // Return the forecasted value of the MFWorld 'that' for the 
 // actor 'iActor'.
 // This is the best value of the transitions from this world,
@@ -271,6 +1087,20 @@ static inline
 #endif
 int MFWorldGetNbTrans(const MFWorld* const that);
 
+// Return true if the status of the MFWorld 'that' is an end status, 
+// else false
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFWorldIsEnd(const MFWorld* const that);
+
+// Return true if one of the transitions of the MFWorld 'that' reaches
+// a world with an end status, else false
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFWorldHasEndChild(const MFWorld* const that);
+
 // Get the number of expandable transition for the MFWorld 'that'
 int MFWorldGetNbTransExpandable(const MFWorld* const that);
 
@@ -305,11 +1135,26 @@ static inline
 const MFTransition* MFWorldTransition(const MFWorld* const that, 
   const int iTrans);
 
-// Get the set of MFTransition reaching the MFWorld 'that'
+// Get the number of MFTransition reaching the MFWorld 'that'
 #if BUILDMODE != 0
 static inline
 #endif
-const GSet* MFWorldSources(const MFWorld* const that);
+int MFWorldGetNbSource(const MFWorld* const that);
+
+// Get the 'iSource'-th MFTransition reaching the MFWorld 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+const MFTransition* MFWorldSource(const MFWorld* const that, 
+  const int iSource);
+
+// Add the MFTransition 'source' to the sources of the MFWorld 'that'
+void MFWorldAddSource(MFWorld* const that, MFTransition* const source);
+
+// Remove the MFTransition 'source' from the sources of the 
+// MFWorld 'that'
+void MFWorldRemoveSource(MFWorld* const that, 
+  const MFTransition* const source);
 
 // Return the array of values of the MFWorld 'that' for each actor
 #if BUILDMODE != 0
@@ -358,6 +1203,20 @@ float MFWorldGetValue(const MFWorld* const that, const int iActor);
 const MFModelTransition* MFBestTransition(
   const MiniFrame* const that, const int iActor);
 
+// Get the 'nb' best transitions from the current world of the 
+// MiniFrame 'that', sorted by decreasing forecast value for the sente
+// of the current world, or for the 'iActor'-th actor if it has no 
+// sente, among the transitions considered by MFBestTransition()
+// The transitions are stored in 'transitions', which must have room 
+// for 'nb' transitions, their forecast values are available with 
+// MFTransitionGetValue()
+// With the alpha-beta expansion, only the values of the 
+// MFGetNbMultiPV() best transitions are exact
+// Return the nb of transitions stored, less than 'nb' if there are 
+// not enough transitions
+int MFGetBestTransitions(const MiniFrame* const that, const int iActor,
+  const int nb, const MFTransition** const transitions);
+
 // Print the MFWorld 'that' on the stream 'stream'
 void MFWorldPrint(const MFWorld* const that, FILE* const stream);
   
@@ -372,6 +1231,9 @@ void MFWorldTransPrintln(const MFWorld* const that,
 // Set the current world of the MiniFrame 'that' to match the 
 // MFModelStatus 'status'
 // If the world is in computed worlds reuse it, else create a new one
+// If the MiniFrame is pondering, the pondering is stopped first, the 
+// worlds it has computed under 'status' are kept and the other ones 
+// are discarded
 void MFSetCurWorld(MiniFrame* const that, 
   const MFModelStatus* const world);
 
@@ -380,6 +1242,19 @@ void MFSetCurWorld(MiniFrame* const that,
 void MFWorldPrintBestStoryln(const MFWorld* const that, 
   const int iActor, FILE* const stream);
 
+// Get the principal variation from the current world of the 
+// MiniFrame 'that', i.e. the sequence of best transitions for the 
+// sente of each world, or for the 'iActor'-th actor if the world has 
+// no sente, until an end world, a world without transition or a world
+// already in the sequence
+// The nb of transitions is returned in 'length'
+// The principal variation is maintained while expanding and rebuilt 
+// only if a best transition along it has changed since the last call
+// The returned array belongs to the MiniFrame and is valid until the 
+// next call to a function modifying the MiniFrame
+const MFTransition* const* MFGetPV(MiniFrame* const that, 
+  const int iActor, int* const length);
+
 // Set the values of the MFWorld 'that' to 'values'
 void MFWorldSetValues(MFWorld* const that, const float* const values);
 
@@ -406,6 +1281,14 @@ static inline
 #endif
 MFExpansionType MFGetExpansionType(const MiniFrame* const that);
 
+// Set the type of expansion for the MiniFrame 'that' to 'type'
+// The type can be changed between two steps of a game: if it differs 
+// from the current one, the worlds computed so far are discarded and 
+// the expansion restarts from the current world
+// Stop the pondering if the MiniFrame is pondering
+void MFSetExpansionType(MiniFrame* const that, 
+  const MFExpansionType type);
+
 // Return true if the MFTransition is expanded, false else
 #if BUILDMODE != 0
 static inline
@@ -427,6 +1310,119 @@ static inline
 #endif
 float MFGetPruningDeltaVal(const MiniFrame* const that);
 
+// Set the margin above which the best transition from the current 
+// world of the MiniFrame 'that' is settled to 'margin', it depends on
+// the scale of the values of the model
+// The expansion stops early, before its time limit, once the best 
+// transition is settled: it has stayed the same for 
+// MF_NBSTABLECHECKSETTLED checks of the stability and its value is 
+// above the value of all the other transitions by at least 'margin', 
+// or it has no alternative, the other transitions leading to end 
+// worlds with a lower value or there is no other transition
+// The alpha-beta only considers the margin and the stability across 
+// its iterations
+// The time saved is reported by MFGetTimeUnusedExpansion(), and kept 
+// on the game clock if it is used
+// If 'margin' is negative the expansion never stops early
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetSettledMargin(MiniFrame* const that, const float margin);
+
+// Get the margin above which the best transition from the current 
+// world of the MiniFrame 'that' is settled
+#if BUILDMODE != 0
+static inline
+#endif
+float MFGetSettledMargin(const MiniFrame* const that);
+
+// Set the nb of expanded worlds between two updates backward of the 
+// forecast values for the MiniFrame 'that' to 'nb'
+// If 'nb' is greater than 1 the expanded worlds are marked and their
+// ancestors are updated once for all of them, deepest first, every 
+// 'nb' expansions and at the end of MFExpand
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetNbExpansionPerBackprop(MiniFrame* const that, const int nb);
+
+// Get the nb of expanded worlds between two updates backward of the 
+// forecast values for the MiniFrame 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+int MFGetNbExpansionPerBackprop(const MiniFrame* const that);
+
+// Set the nb of threads used during expansion for the MiniFrame 'that' 
+// to 'nb'
+// With the expansion by value, width or depth, 'nb' - 1 worker 
+// threads create along the calling thread the worlds reached from the
+// next worlds of the frontier, the calling thread links them to the 
+// graph and updates the forecast values
+// With the MCTS expansion, 'nb' - 1 worker threads search along the
+// calling thread, either the same tree (cf MFSetTreeParallel) or their
+// own tree from the current world, in which case the statistics of 
+// the transitions from the current world are merged at the end of 
+// MFExpand
+// In both cases the functions of the model must be thread safe
+// The alpha-beta expansion ignores this setting
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetNbThread(MiniFrame* const that, const int nb);
+
+// Get the nb of threads used during expansion for the MiniFrame 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+int MFGetNbThread(const MiniFrame* const that);
+
+// Set the flag controling if the threads of the MCTS expansion share 
+// one tree for the MiniFrame 'that' to 'flag'
+// If true, all the threads search the tree of the current world, with 
+// a virtual loss on the transitions they are playing out, else each 
+// worker thread searches its own tree
+// The other expansion types ignore this setting
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetTreeParallel(MiniFrame* const that, const bool flag);
+
+// Return the flag controling if the threads of the MCTS expansion 
+// share one tree for the MiniFrame 'that'
+#if BUILDMODE != 0
+static inline
+#endif
+bool MFIsTreeParallel(const MiniFrame* const that);
+
+// Set the nb of best lines from the current world the expansion of
+// the MiniFrame 'that' keeps resolved to 'nb'
+// With the MCTS expansion, the playouts from the current world through
+// one of its 'nb' best transitions go through the least visited of 
+// them, so that their statistics are of similar accuracy, the other 
+// transitions are still explored according to their upper confidence
+// bound
+// With the alpha-beta expansion, the window at the current world is 
+// opened with the 'nb'-th best value instead of the best one, so that
+// the values of the 'nb' best transitions are exact and not only 
+// upper bounds
+// The expansions by value, width and depth ignore this setting, the 
+// expansion by width resolves anyway all the lines to the same depth
+// If 'nb' is less than 1 it is converted to 1
+#if BUILDMODE != 0
+static inline
+#endif
+void MFSetNbMultiPV(MiniFrame* const that, const int nb);
+
+// Get the nb of best lines from the current world the expansion of 
+// the MiniFrame 'that' keeps resolved
+#if BUILDMODE != 0
+static inline
+#endif
+int MFGetNbMultiPV(const MiniFrame* const that);
+
 // Get the nb of worlds not found during MFSetCurWorld
 #if BUILDMODE != 0
 static inline